@@ -0,0 +1,287 @@
+// PoolAllocator 与 std::allocator 在各容器上的对比基准（Google Benchmark）。
+// - 容器：std::map、std::list、std::unordered_map、HashMap（开放寻址）、SimpleSeq；
+// - 分配器：std::allocator、PoolAllocator（不预留 / 预留 n 个）、多线程共享的 ConcurrentPoolAllocator；
+//   “预留”按容器各自的方式做：节点容器用 PoolAllocator(n) 预留节点，数组容器调用容器的 reserve(n)；
+// - 规模：1e3 ~ 1e7，单线程和多线程各跑一遍；
+// - 插入、删除每 64 次抽样计时一次，遍历每 64 段抽一段 64 个元素计时（折算成每个元素），
+//   给出 p50 / p99 延迟计数器（多线程时取各线程的平均）。
+// 运行 `cmake --build <dir> --target run_benchmarks` 会把结果写到 benchmark_results.json。
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "../include/poolAllocator.hpp"
+#include "../include/concurrentPoolAllocator.hpp"
+#include "../include/simpleSeq.hpp"
+#include "../include/hashMap.hpp"
+
+namespace {
+
+// make<T>(nodes) 得到容器用的分配器；reserved 为真时 nodes 是要预先留出的节点数，
+// 数组容器传 0，改由容器自己 reserve
+struct StdAlloc {
+    static constexpr const char* name = "std_allocator";
+    static constexpr bool reserved = false;
+    template <class T> using alloc_t = std::allocator<T>;
+    template <class T> static alloc_t<T> make(std::size_t) { return alloc_t<T>(); }
+};
+
+struct Pool {
+    static constexpr const char* name = "PoolAllocator";
+    static constexpr bool reserved = false;
+    template <class T> using alloc_t = PoolAllocator<T>;
+    template <class T> static alloc_t<T> make(std::size_t) { return alloc_t<T>(); }
+};
+
+// 预留额度落在第一个分配对象的桶上，也就是容器 rebind 出的节点桶
+struct PoolReserved {
+    static constexpr const char* name = "PoolAllocator_reserved";
+    static constexpr bool reserved = true;
+    template <class T> using alloc_t = PoolAllocator<T>;
+    template <class T> static alloc_t<T> make(std::size_t nodes) { return alloc_t<T>(nodes); }
+};
+
+// 所有线程共用同一个池，衡量 magazine 的扩展性
+struct SharedConcurrentPool {
+    static constexpr const char* name = "ConcurrentPoolAllocator_shared";
+    static constexpr bool reserved = false;
+    template <class T> using alloc_t = ConcurrentPoolAllocator<T>;
+    template <class T> static alloc_t<T> make(std::size_t) {
+        static ConcurrentPoolAllocator<char> shared;
+        return alloc_t<T>(shared);
+    }
+};
+
+template <class P>
+struct MapC {
+    static constexpr const char* name = "std_map";
+    static constexpr bool erasable = true;
+    using value_type = std::pair<const int, int>;
+    using type = std::map<int, int, std::less<int>, typename P::template alloc_t<value_type>>;
+    static type make(std::size_t n) { return type(std::less<int>(), P::template make<value_type>(n)); }
+    static void insert(type& c, int k) { c.emplace(k, k); }
+    static void erase(type& c, int k) { c.erase(k); }
+};
+
+template <class P>
+struct ListC {
+    static constexpr const char* name = "std_list";
+    static constexpr bool erasable = true;
+    using type = std::list<int, typename P::template alloc_t<int>>;
+    static type make(std::size_t n) { return type(P::template make<int>(n)); }
+    static void insert(type& c, int k) { c.push_back(k); }
+    static void erase(type& c, int) { c.pop_front(); }
+};
+
+template <class P>
+struct UnorderedMapC {
+    static constexpr const char* name = "std_unordered_map";
+    static constexpr bool erasable = true;
+    using value_type = std::pair<const int, int>;
+    using type = std::unordered_map<int, int, std::hash<int>, std::equal_to<int>,
+                                    typename P::template alloc_t<value_type>>;
+    // 节点走分配器的预留，桶数组由容器预留
+    static type make(std::size_t n) {
+        type c(0, std::hash<int>(), std::equal_to<int>(), P::template make<value_type>(n));
+        if (P::reserved) c.reserve(n);
+        return c;
+    }
+    static void insert(type& c, int k) { c.emplace(k, k); }
+    static void erase(type& c, int k) { c.erase(k); }
+};
+
+template <class P>
+struct HashMapC {
+    static constexpr const char* name = "HashMap";
+    static constexpr bool erasable = true;
+    using value_type = std::pair<const int, int>;
+    using type = HashMap<int, int, std::hash<int>, std::equal_to<int>, typename P::template alloc_t<value_type>>;
+    // 开放寻址，元素都在一个数组里
+    static type make(std::size_t n) {
+        type c(0, std::hash<int>(), std::equal_to<int>(), P::template make<value_type>(0));
+        if (P::reserved) c.reserve(n);
+        return c;
+    }
+    static void insert(type& c, int k) { c.try_emplace(k, k); }
+    static void erase(type& c, int k) { c.erase(k); }
+};
+
+template <class P>
+struct SeqC {
+    static constexpr const char* name = "SimpleSeq";
+    static constexpr bool erasable = false;
+    using type = SimpleSeq<int, typename P::template alloc_t<int>>;
+    static type make(std::size_t n) {
+        type c(0, P::template make<int>(0));
+        if (P::reserved) c.reserve(n);
+        return c;
+    }
+    static void insert(type& c, int k) { c.push_back(k); }
+    static void erase(type&, int) {}
+};
+
+const std::vector<int>& shuffled_keys(std::size_t n) {
+    thread_local std::map<std::size_t, std::vector<int>> cache;
+    auto& keys = cache[n];
+    if (keys.empty()) {
+        keys.resize(n);
+        for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<int>(i);
+        std::mt19937 rng(12345);
+        std::shuffle(keys.begin(), keys.end(), rng);
+    }
+    return keys;
+}
+
+constexpr std::size_t latency_sample_every = 64;
+
+// 第 i 次操作是抽样点时计时，耗时记进 samples
+template <class F>
+void sampled(std::size_t i, std::vector<std::int64_t>& samples, F&& op) {
+    if (i % latency_sample_every != 0) {
+        op();
+        return;
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    op();
+    auto t1 = std::chrono::steady_clock::now();
+    samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+}
+
+// 每个样本覆盖 per_sample 次操作时，报告的是折算到单次操作的延迟
+void report_latency(benchmark::State& state, std::vector<std::int64_t>& samples, std::size_t per_sample = 1) {
+    if (samples.empty()) return;
+    std::sort(samples.begin(), samples.end());
+    auto pick = [&](double q) {
+        return static_cast<double>(samples[static_cast<std::size_t>(q * (samples.size() - 1))]) /
+               static_cast<double>(per_sample);
+    };
+    state.counters["p50_ns"] = benchmark::Counter(pick(0.50), benchmark::Counter::kAvgThreads);
+    state.counters["p99_ns"] = benchmark::Counter(pick(0.99), benchmark::Counter::kAvgThreads);
+}
+
+template <template <class> class C, class P>
+void BM_Insert(benchmark::State& state) {
+    using Cont = C<P>;
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const auto& keys = shuffled_keys(n);
+    std::vector<std::int64_t> samples;
+    samples.reserve(n / latency_sample_every + 1);
+    for (auto _ : state) {
+        samples.clear();
+        {
+            auto c = Cont::make(n);
+            for (std::size_t i = 0; i < n; ++i) sampled(i, samples, [&] { Cont::insert(c, keys[i]); });
+            benchmark::DoNotOptimize(c);
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    report_latency(state, samples);
+}
+
+template <template <class> class C, class P>
+void BM_Erase(benchmark::State& state) {
+    using Cont = C<P>;
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const auto& keys = shuffled_keys(n);
+    std::vector<std::int64_t> samples;
+    samples.reserve(n / latency_sample_every + 1);
+    for (auto _ : state) {
+        state.PauseTiming();
+        samples.clear();
+        {
+            auto c = Cont::make(n);
+            for (std::size_t i = 0; i < n; ++i) Cont::insert(c, keys[i]);
+            state.ResumeTiming();
+            for (std::size_t i = 0; i < n; ++i) sampled(i, samples, [&] { Cont::erase(c, keys[n - 1 - i]); });
+            benchmark::DoNotOptimize(c);
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    report_latency(state, samples);
+}
+
+template <template <class> class C, class P>
+void BM_Iterate(benchmark::State& state) {
+    using Cont = C<P>;
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const auto& keys = shuffled_keys(n);
+    auto c = Cont::make(n);
+    for (std::size_t i = 0; i < n; ++i) Cont::insert(c, keys[i]);
+    // 每轮只有 n / 4096 个样本，所以累积所有轮的样本；一轮遍历的耗时与 n 成正比，总数有上限
+    std::vector<std::int64_t> samples;
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        auto it = c.begin();
+        const auto end = c.end();
+        // 单个元素太快，计时开销盖过它；按 latency_sample_every 个元素一段来抽样
+        for (std::size_t chunk = 0; it != end; ++chunk) {
+            sampled(chunk, samples, [&] {
+                for (std::size_t k = 0; k < latency_sample_every && it != end; ++k, ++it) {
+                    const auto& v = *it;
+                    if constexpr (std::is_same<std::decay_t<decltype(v)>, int>::value) sum += v;
+                    else sum += v.second;
+                }
+            });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    report_latency(state, samples, latency_sample_every);
+}
+
+int worker_threads() {
+    return static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+}
+
+template <template <class> class C, class P>
+void register_ops() {
+    const std::string base = std::string(C<P>::name) + "/" + P::name;
+    auto configure = [](benchmark::internal::Benchmark* b) {
+        b->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond)
+         ->UseRealTime()->Threads(1)->Threads(worker_threads());
+    };
+    configure(benchmark::RegisterBenchmark((base + "/insert").c_str(), BM_Insert<C, P>));
+    if (C<P>::erasable)
+        configure(benchmark::RegisterBenchmark((base + "/erase").c_str(), BM_Erase<C, P>));
+    configure(benchmark::RegisterBenchmark((base + "/iterate").c_str(), BM_Iterate<C, P>));
+}
+
+template <template <class> class C>
+void register_container() {
+    register_ops<C, StdAlloc>();
+    register_ops<C, Pool>();
+    register_ops<C, PoolReserved>();
+    register_ops<C, SharedConcurrentPool>();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    register_container<MapC>();
+    register_container<ListC>();
+    register_container<UnorderedMapC>();
+    register_container<HashMapC>();
+    register_container<SeqC>();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 分配事件跟踪（编译期开关 POOL_ALLOCATOR_TRACE=1）：
+// - PoolAllocator、ConcurrentPoolAllocator 和 PoolResource 的每次 allocate / deallocate / 原地扩容
+//   都往一个全局环形缓冲区里写一条 32 字节的定长记录（时间、地址、元素个数和大小、对齐、线程）；
+// - 写入是一次 fetch_add 加一次普通写，不加锁、不分配；缓冲区写满后覆盖最早的记录；
+// - 缓冲区在第一次记录时分配，容量由 POOL_ALLOCATOR_TRACE_EVENTS 决定（默认 2^20 条，32 MiB）；
+// - write_file() 按时间顺序把记录写成二进制文件，tools/ 里的 poolTraceReplay 读它，
+//   用不同的 PoolOptions 重放，比较耗时、峰值 RSS 和 malloc 次数。
+// 保存文件时应当没有线程还在分配，否则正在写的记录可能不完整。
+// 关闭跟踪时这个头文件不会被包含，热路径上没有任何额外代码。
+
+#ifndef POOL_ALLOCATOR_TRACE_EVENTS
+#define POOL_ALLOCATOR_TRACE_EVENTS (std::size_t(1) << 20)
+#endif
+
+enum class AllocTraceKind : std::uint8_t { allocate = 1, deallocate = 2, expand = 3 };
+
+struct AllocTraceEvent {
+    std::uint64_t time_ns;
+    std::uint64_t address;
+    // 元素个数；expand 记录的是扩容后的个数
+    std::uint64_t count;
+    std::uint32_t elem_size;
+    std::uint16_t thread;
+    std::uint8_t align_log2;
+    AllocTraceKind kind;
+};
+
+static_assert(sizeof(AllocTraceEvent) == 32, "trace records are meant to stay 32 bytes");
+
+struct AllocTraceHeader {
+    static constexpr std::uint32_t current_version = 1;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t event_size;
+    std::uint64_t event_count;
+    // 因环形缓冲区写满而被覆盖的记录数
+    std::uint64_t dropped;
+};
+
+namespace trace_detail {
+
+inline constexpr char trace_magic[8] = {'P', 'O', 'O', 'L', 'T', 'R', 'C', '1'};
+
+inline std::uint16_t thread_id() noexcept {
+    static std::atomic<std::uint16_t> next{0};
+    thread_local std::uint16_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+inline std::uint8_t log2_of(std::size_t align) noexcept {
+    std::uint8_t k = 0;
+    while ((std::size_t(1) << k) < align) ++k;
+    return k;
+}
+
+} // namespace trace_detail
+
+class AllocTraceBuffer {
+public:
+    using size_type = std::size_t;
+
+    // capacity 向上取整到 2 的幂
+    explicit AllocTraceBuffer(size_type capacity = POOL_ALLOCATOR_TRACE_EVENTS) {
+        size_type cap = 1;
+        while (cap < capacity) cap <<= 1;
+        events_.reset(new AllocTraceEvent[cap]);
+        mask_ = cap - 1;
+    }
+
+    AllocTraceBuffer(const AllocTraceBuffer&) = delete;
+    AllocTraceBuffer& operator=(const AllocTraceBuffer&) = delete;
+
+    static AllocTraceBuffer& global() {
+        static AllocTraceBuffer buffer;
+        return buffer;
+    }
+
+    void record(AllocTraceKind kind, const void* p, size_type count, size_type elem_size, size_type align) noexcept {
+        std::uint64_t i = next_.fetch_add(1, std::memory_order_relaxed);
+        AllocTraceEvent& e = events_[i & mask_];
+        e.time_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                   std::chrono::steady_clock::now().time_since_epoch())
+                                                   .count());
+        e.address = reinterpret_cast<std::uintptr_t>(p);
+        e.count = count;
+        e.elem_size = static_cast<std::uint32_t>(elem_size);
+        e.thread = trace_detail::thread_id();
+        e.align_log2 = trace_detail::log2_of(align);
+        e.kind = kind;
+    }
+
+    size_type capacity() const noexcept { return mask_ + 1; }
+    // 一共记录过多少条（包括已被覆盖的）
+    std::uint64_t recorded() const noexcept { return next_.load(std::memory_order_relaxed); }
+
+    // 缓冲区里还保留着的记录，按写入顺序
+    std::vector<AllocTraceEvent> snapshot() const {
+        std::uint64_t end = recorded();
+        std::uint64_t begin = end > capacity() ? end - capacity() : 0;
+        std::vector<AllocTraceEvent> out;
+        out.reserve(static_cast<size_type>(end - begin));
+        for (std::uint64_t i = begin; i < end; ++i) out.push_back(events_[i & mask_]);
+        return out;
+    }
+
+    void clear() noexcept { next_.store(0, std::memory_order_relaxed); }
+
+    void write_file(const std::string& path) const {
+        std::vector<AllocTraceEvent> events = snapshot();
+        AllocTraceHeader h;
+        std::memcpy(h.magic, trace_detail::trace_magic, sizeof(h.magic));
+        h.version = AllocTraceHeader::current_version;
+        h.event_size = sizeof(AllocTraceEvent);
+        h.event_count = events.size();
+        h.dropped = recorded() - events.size();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("AllocTraceBuffer: cannot open " + path);
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(events.data()),
+                  static_cast<std::streamsize>(events.size() * sizeof(AllocTraceEvent)));
+        if (!out) throw std::runtime_error("AllocTraceBuffer: write failed for " + path);
+    }
+
+private:
+    std::unique_ptr<AllocTraceEvent[]> events_;
+    size_type mask_ = 0;
+    std::atomic<std::uint64_t> next_{0};
+};
+
+// 读回 write_file() 写的文件；header 可选
+inline std::vector<AllocTraceEvent> read_alloc_trace(const std::string& path, AllocTraceHeader* header = nullptr) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("read_alloc_trace: cannot open " + path);
+    AllocTraceHeader h;
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    if (!in || std::memcmp(h.magic, trace_detail::trace_magic, sizeof(h.magic)) != 0 ||
+        h.version != AllocTraceHeader::current_version || h.event_size != sizeof(AllocTraceEvent))
+        throw std::runtime_error("read_alloc_trace: not a pool trace file: " + path);
+    std::vector<AllocTraceEvent> events(static_cast<std::size_t>(h.event_count));
+    in.read(reinterpret_cast<char*>(events.data()),
+            static_cast<std::streamsize>(events.size() * sizeof(AllocTraceEvent)));
+    if (!in) throw std::runtime_error("read_alloc_trace: truncated trace file: " + path);
+    if (header) *header = h;
+    return events;
+}
+
+namespace pool_detail {
+
+inline void trace_event(AllocTraceKind kind, const void* p, std::size_t count, std::size_t elem_size,
+                        std::size_t align) noexcept {
+    AllocTraceBuffer::global().record(kind, p, count, elem_size, align);
+}
+
+} // namespace pool_detail
@@ -0,0 +1,148 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include "poolAllocator.hpp"
+
+// 单调（arena）分配器：在当前内存块里移动指针分配，deallocate 什么也不做。
+// reset() 把指针拨回第一块，所有块留着复用，耗时与分配过多少对象无关。
+// 适合“每个请求建一个 std::map，用完整个丢掉”的场景：
+// 先让容器析构（或直接放弃），再调用 reset()。
+// 所有拷贝和 rebind 得到的 ArenaAllocator 共享同一个 arena。
+
+namespace pool_detail {
+
+class MonotonicArena {
+public:
+    static constexpr size_type default_initial_bytes = 4096;
+    static constexpr size_type max_block_bytes = size_type(64) << 20;
+
+    explicit MonotonicArena(size_type initial_bytes = default_initial_bytes) noexcept
+        : next_bytes_(std::max<size_type>(initial_bytes, 2 * header_size)) {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() noexcept { release_all(); }
+
+    void* allocate(size_type bytes, size_type align) {
+        if (void* p = bump(bytes, align)) return p;
+        return allocate_slow(bytes, align);
+    }
+
+    // 回到第一块重新分配，之前分配的对象全部作废
+    void reset() noexcept {
+        if (first_) use(first_);
+    }
+
+    void release_all() noexcept {
+        Chunk* c = first_;
+        while (c) {
+            Chunk* next = c->next;
+            deallocate_bytes(c, alignof(Chunk));
+            c = next;
+        }
+        first_ = current_ = nullptr;
+        cur_ = end_ = nullptr;
+    }
+
+private:
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* next;
+        size_type size;
+    };
+    static constexpr size_type header_size = sizeof(Chunk);
+
+    Chunk* first_ = nullptr;
+    Chunk* current_ = nullptr;
+    char* cur_ = nullptr;
+    char* end_ = nullptr;
+    size_type next_bytes_;
+
+    void* bump(size_type bytes, size_type align) noexcept {
+        std::uintptr_t c = reinterpret_cast<std::uintptr_t>(cur_);
+        std::uintptr_t p = (c + align - 1) & ~std::uintptr_t(align - 1);
+        std::uintptr_t e = reinterpret_cast<std::uintptr_t>(end_);
+        if (!cur_ || p > e || bytes > e - p) return nullptr;
+        cur_ = reinterpret_cast<char*>(p + bytes);
+        return reinterpret_cast<void*>(p);
+    }
+
+    void use(Chunk* c) noexcept {
+        current_ = c;
+        cur_ = reinterpret_cast<char*>(c) + header_size;
+        end_ = reinterpret_cast<char*>(c) + c->size;
+    }
+
+    void* allocate_slow(size_type bytes, size_type align) {
+        // reset() 之后先把后面留着的块依次用起来
+        for (Chunk* c = current_ ? current_->next : first_; c; c = c->next) {
+            use(c);
+            if (void* p = bump(bytes, align)) return p;
+        }
+        size_type pad = align > alignof(Chunk) ? align : 0;
+        if (bytes > ~size_type(0) - header_size - pad) throw std::bad_alloc();
+        size_type need = header_size + bytes + pad;
+        size_type size = std::max(need, next_bytes_);
+        next_bytes_ = std::min(next_bytes_ * 2, std::max(max_block_bytes, next_bytes_));
+        Chunk* c = static_cast<Chunk*>(allocate_bytes(size, alignof(Chunk)));
+        c->size = size;
+        if (current_) {
+            c->next = current_->next;
+            current_->next = c;
+        } else {
+            c->next = first_;
+            first_ = c;
+        }
+        use(c);
+        return bump(bytes, align);
+    }
+};
+
+} // namespace pool_detail
+
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using pointer = T*;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <class U> struct rebind { using other = ArenaAllocator<U>; };
+
+    ArenaAllocator(size_type initial_bytes = pool_detail::MonotonicArena::default_initial_bytes)
+        : arena_(std::make_shared<pool_detail::MonotonicArena>(initial_bytes)) {}
+
+    ArenaAllocator(const ArenaAllocator& other) noexcept = default;
+    ArenaAllocator& operator=(const ArenaAllocator& other) noexcept = default;
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+    pointer allocate(size_type n) {
+        if (n == 0) return nullptr;
+        if (n > max_size()) throw std::bad_array_new_length();
+        return static_cast<pointer>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(pointer, size_type) noexcept {}
+
+    size_type max_size() const noexcept { return ~size_type(0) / sizeof(T); }
+
+    void reset() noexcept { arena_->reset(); }
+
+    void release_all() noexcept { arena_->release_all(); }
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena_ == other.arena_; }
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return !(*this == other); }
+
+private:
+    template <class U> friend class ArenaAllocator;
+
+    std::shared_ptr<pool_detail::MonotonicArena> arena_;
+};
@@ -0,0 +1,414 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "poolAllocator.hpp"
+#include "lockFreeStack.hpp"
+
+// 可跨线程共享的 PoolAllocator 变体（tcmalloc 风格）。
+// - 每个线程在每个桶里有一个 magazine（本线程私有的空闲槽位链表），命中时无需加锁；
+// - magazine 空了从中心空闲链表成批取 batch_size 个，满了成批还回去；
+// - 中心链表是带版本号的无锁栈，deallocate 可以在任意线程调用，不需要加锁；
+//   不能保证指针打包的平台上退回自旋锁保护的栈（见 lockFreeStack.hpp）；
+// - 每个 magazine 记录命中/未命中次数，可用 thread_stats() 查看。
+
+namespace pool_detail {
+
+constexpr size_type cache_line_size = 64;
+
+// 给每个线程分配一个小整数编号，线程退出后编号回收复用。
+// 编号用完（超过 max_slots 个线程同时存在）的线程拿到 none，直接走中心链表。
+class ThreadSlots {
+public:
+    static constexpr size_type max_slots = 128;
+    static constexpr size_type none = max_slots;
+
+    static size_type current() noexcept {
+        thread_local Holder holder;
+        return holder.id;
+    }
+
+private:
+    struct Registry {
+        std::mutex mutex;
+        bool used[max_slots] = {};
+    };
+
+    static Registry& registry() noexcept {
+        static Registry r;
+        return r;
+    }
+
+    struct Holder {
+        size_type id = none;
+
+        Holder() noexcept {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (size_type i = 0; i < max_slots; ++i) {
+                if (!r.used[i]) {
+                    r.used[i] = true;
+                    id = i;
+                    break;
+                }
+            }
+        }
+
+        ~Holder() noexcept {
+            if (id == none) return;
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.used[id] = false;
+        }
+    };
+};
+
+// 中心空闲链表：所有线程共享，按批（batch）存取。
+// 每批的第一个槽位充当无锁栈节点，rest 指向本批其余槽位组成的链表；
+// 成批存取都是一次 CAS，只有扩容时才加锁。
+// 因此任何线程都可以无锁地归还别的线程分配的槽位。
+class CentralFreeList {
+public:
+    // 批次节点占用两个指针，槽位步长至少要这么大
+    static constexpr size_type min_stride = 2 * sizeof(void*);
+    static constexpr size_type batch_size = 32;
+
+    // credit 是所属 ConcurrentPoolState 的一次性预留额度，第一次扩容的链表把它取走
+    CentralFreeList(size_type stride, size_type align, const PoolOptions& options,
+                    std::atomic<size_type>* credit = nullptr) noexcept
+        : stride_(stride), align_(align), sizer(options), credit_(credit) {}
+
+    CentralFreeList(const CentralFreeList&) = delete;
+    CentralFreeList& operator=(const CentralFreeList&) = delete;
+
+    ~CentralFreeList() noexcept {
+        for (void* b : blocks) sizer.deallocate_block(b, align_);
+    }
+
+    size_type stride() const noexcept { return stride_; }
+    size_type align() const noexcept { return align_; }
+
+    // 取出一批槽位串成的链表，返回实际个数（至少 1 个）
+    size_type pop_batch(Slot*& out) {
+        BatchNode* node = batches.pop();
+        if (!node) node = expand(1);
+        Slot* rest = node->rest;
+        node->~BatchNode();
+        Slot* first = reinterpret_cast<Slot*>(node);
+        first->next = rest;
+        size_type n = 1;
+        for (Slot* s = rest; s; s = s->next) ++n;
+        out = first;
+        return n;
+    }
+
+    void push_chain(Slot* first) noexcept {
+        Slot* rest = first->next;
+        BatchNode* node = ::new (static_cast<void*>(first)) BatchNode;
+        node->rest = rest;
+        batches.push(node);
+    }
+
+private:
+    struct BatchNode {
+        std::atomic<BatchNode*> next{nullptr};
+        Slot* rest = nullptr;
+    };
+
+    size_type stride_;
+    size_type align_;
+    BlockSizer sizer;
+    std::atomic<size_type>* credit_;
+    ConcurrentStack<BatchNode> batches;
+    std::mutex expand_mutex;
+    std::vector<void*> blocks;
+    size_type total_slots = 0;
+
+    BatchNode* expand(size_type count) {
+        std::lock_guard<std::mutex> lock(expand_mutex);
+        // 抢锁期间别的线程可能已经扩过容了
+        if (BatchNode* node = batches.pop()) return node;
+        if (credit_) count = std::max(count, credit_->exchange(0, std::memory_order_relaxed));
+        return push_block(count);
+    }
+
+    // 新块切成 batch_size 个一批：第一批直接交给调用方，其余压进无锁栈。
+    // 压进去的批随时会被其他线程不加锁地取走，所以不能压完再 pop 回来；调用方持有 expand_mutex
+    BatchNode* push_block(size_type count) {
+        size_type block_slots = align_up(sizer.next_block_slots(count, stride_), batch_size);
+        blocks.reserve(blocks.size() + 1);
+        void* raw = sizer.allocate_block(sizer.block_bytes(block_slots, stride_), align_);
+        blocks.push_back(raw);
+        char* base = static_cast<char*>(raw);
+        for (size_type b = 0; b < block_slots; b += batch_size) {
+            Slot* first = reinterpret_cast<Slot*>(base + b * stride_);
+            for (size_type i = 0; i + 1 < batch_size; ++i) {
+                Slot* s = reinterpret_cast<Slot*>(base + (b + i) * stride_);
+                s->next = reinterpret_cast<Slot*>(base + (b + i + 1) * stride_);
+            }
+            reinterpret_cast<Slot*>(base + (b + batch_size - 1) * stride_)->next = nullptr;
+            if (b != 0) push_chain(first);
+        }
+        total_slots += block_slots;
+        Slot* first = reinterpret_cast<Slot*>(base);
+        Slot* rest = first->next;
+        BatchNode* node = ::new (static_cast<void*>(first)) BatchNode;
+        node->rest = rest;
+        return node;
+    }
+};
+
+struct alignas(cache_line_size) Magazine {
+    Slot* head = nullptr;
+    size_type count = 0;
+    // 只有所属线程写入，其他线程读统计时用 relaxed 读
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+};
+
+inline void bump(std::atomic<std::uint64_t>& c) noexcept {
+    c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+class ConcurrentSlab {
+public:
+    static constexpr size_type batch_size = CentralFreeList::batch_size;
+
+    ConcurrentSlab(size_type stride, size_type align, const PoolOptions& options,
+                   std::atomic<size_type>* credit = nullptr)
+        : central(stride, align, options, credit), magazines(new Magazine[ThreadSlots::max_slots]) {}
+
+    size_type stride() const noexcept { return central.stride(); }
+    size_type align() const noexcept { return central.align(); }
+
+    void* allocate() {
+        size_type t = ThreadSlots::current();
+        if (t == ThreadSlots::none) return pop_central();
+        Magazine& m = magazines[t];
+        if (m.head) {
+            bump(m.hits);
+        } else {
+            bump(m.misses);
+            m.count = central.pop_batch(m.head);
+        }
+        Slot* s = m.head;
+        m.head = s->next;
+        --m.count;
+        return s;
+    }
+
+    void deallocate(void* p) noexcept {
+        Slot* s = static_cast<Slot*>(p);
+        size_type t = ThreadSlots::current();
+        if (t == ThreadSlots::none) {
+            s->next = nullptr;
+            central.push_chain(s);
+            return;
+        }
+        Magazine& m = magazines[t];
+        s->next = m.head;
+        m.head = s;
+        if (++m.count >= 2 * batch_size) spill(m);
+    }
+
+    const Magazine& magazine(size_type t) const noexcept { return magazines[t]; }
+
+private:
+    CentralFreeList central;
+    std::unique_ptr<Magazine[]> magazines;
+
+    void* pop_central() {
+        Slot* s = nullptr;
+        central.pop_batch(s);
+        if (s->next) central.push_chain(s->next);
+        return s;
+    }
+
+    void spill(Magazine& m) noexcept {
+        Slot* first = m.head;
+        Slot* last = first;
+        for (size_type i = 1; i < batch_size; ++i) last = last->next;
+        m.head = last->next;
+        m.count -= batch_size;
+        last->next = nullptr;
+        central.push_chain(first);
+    }
+};
+
+class ConcurrentPoolState {
+public:
+    explicit ConcurrentPoolState(const PoolOptions& options) noexcept : options_(options) {}
+    ConcurrentPoolState(const ConcurrentPoolState&) = delete;
+    ConcurrentPoolState& operator=(const ConcurrentPoolState&) = delete;
+
+    ConcurrentSlab* pool_for(size_type stride, size_type align) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& p : pools)
+            if (p->stride() == stride && p->align() == align) return p.get();
+        pools.push_back(std::make_unique<ConcurrentSlab>(stride, align, options_, &reserve_credit));
+        return pools.back().get();
+    }
+
+    // 与 PoolState::reserve_first 相同：额度留给第一个需要扩容的桶，多次调用取最大值
+    void reserve_first(size_type count) noexcept {
+        size_type cur = reserve_credit.load(std::memory_order_relaxed);
+        while (cur < count && !reserve_credit.compare_exchange_weak(cur, count, std::memory_order_relaxed)) {
+        }
+    }
+
+    void* allocate_large(size_type bytes, size_type align) {
+        std::lock_guard<std::mutex> lock(large_mutex);
+        return large.allocate(bytes, align);
+    }
+
+    void deallocate_large(void* p, size_type bytes = 0) noexcept {
+        std::lock_guard<std::mutex> lock(large_mutex);
+        large.deallocate(p, bytes);
+    }
+
+    bool try_expand_large(void* p, size_type new_bytes) noexcept {
+        std::lock_guard<std::mutex> lock(large_mutex);
+        return large.try_expand(p, new_bytes);
+    }
+
+    template <class F>
+    void for_each_pool(F&& f) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& p : pools) f(*p);
+    }
+
+private:
+    PoolOptions options_;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<ConcurrentSlab>> pools;
+    std::atomic<size_type> reserve_credit{0};
+
+    std::mutex large_mutex;
+    LargeBins large;
+};
+
+} // namespace pool_detail
+
+struct ThreadCacheStats {
+    std::size_t thread_slot;
+    std::uint64_t hits;
+    std::uint64_t misses;
+};
+
+template <typename T>
+class ConcurrentPoolAllocator {
+public:
+    using value_type = T;
+    using pointer = T*;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <class U> struct rebind { using other = ConcurrentPoolAllocator<U>; };
+
+    ConcurrentPoolAllocator(size_type initial_capacity = 0, const PoolOptions& options = default_options())
+        : state_(std::make_shared<pool_detail::ConcurrentPoolState>(options)),
+          slab_(state_->pool_for(stride, align)) {
+        if (initial_capacity > 0) reserve(initial_capacity);
+    }
+
+    ConcurrentPoolAllocator(const ConcurrentPoolAllocator& other) noexcept = default;
+    ConcurrentPoolAllocator& operator=(const ConcurrentPoolAllocator& other) noexcept = default;
+
+    template <class U>
+    ConcurrentPoolAllocator(const ConcurrentPoolAllocator<U>& other) noexcept : state_(other.state_) {
+        try {
+            slab_ = state_->pool_for(stride, align);
+        } catch (...) {
+            slab_ = nullptr;
+        }
+    }
+
+    pointer allocate(size_type n) {
+        if (n == 0) return nullptr;
+        pointer p;
+        if (n == 1) {
+            p = static_cast<pointer>(slab()->allocate());
+        } else {
+            if (n > max_size()) throw std::bad_array_new_length();
+            p = static_cast<pointer>(state_->allocate_large(n * sizeof(T), alignof(T)));
+        }
+#if POOL_ALLOCATOR_TRACE
+        pool_detail::trace_event(AllocTraceKind::allocate, p, n, sizeof(T), alignof(T));
+#endif
+        return p;
+    }
+
+    void deallocate(pointer p, size_type n) noexcept {
+        if (!p) return;
+#if POOL_ALLOCATOR_TRACE
+        pool_detail::trace_event(AllocTraceKind::deallocate, p, n, sizeof(T), alignof(T));
+#endif
+        if (n == 1) {
+            slab()->deallocate(p);
+        } else {
+            state_->deallocate_large(p, n * sizeof(T));
+        }
+    }
+
+    size_type max_size() const noexcept { return ~size_type(0) / sizeof(T); }
+
+    bool try_expand(pointer p, size_type old_n, size_type new_n) noexcept {
+        if (!p || old_n <= 1 || new_n <= old_n || new_n > max_size()) return false;
+#if POOL_ALLOCATOR_TRACE
+        if (!state_->try_expand_large(p, new_n * sizeof(T))) return false;
+        pool_detail::trace_event(AllocTraceKind::expand, p, new_n, sizeof(T), alignof(T));
+        return true;
+#else
+        return state_->try_expand_large(p, new_n * sizeof(T));
+#endif
+    }
+
+    // 中心链表按批存取，首块给大一些，避免多个线程一开始就抢着扩容
+    static PoolOptions default_options() noexcept {
+        PoolOptions o;
+        o.initial_block_slots = 4 * pool_detail::CentralFreeList::batch_size;
+        return o;
+    }
+
+    // 预留额度留给第一个需要扩容的桶，见 PoolAllocator::reserve
+    void reserve(size_type new_cap) {
+        state_->reserve_first(new_cap);
+    }
+
+    // 各线程 magazine 的命中/未命中次数（所有桶合计），只列出用过的线程编号
+    std::vector<ThreadCacheStats> thread_stats() const {
+        std::vector<ThreadCacheStats> out;
+        for (size_type t = 0; t < pool_detail::ThreadSlots::max_slots; ++t) {
+            ThreadCacheStats s{t, 0, 0};
+            state_->for_each_pool([&](const pool_detail::ConcurrentSlab& p) {
+                s.hits += p.magazine(t).hits.load(std::memory_order_relaxed);
+                s.misses += p.magazine(t).misses.load(std::memory_order_relaxed);
+            });
+            if (s.hits || s.misses) out.push_back(s);
+        }
+        return out;
+    }
+
+    template <class U>
+    bool operator==(const ConcurrentPoolAllocator<U>& other) const noexcept { return state_ == other.state_; }
+    template <class U>
+    bool operator!=(const ConcurrentPoolAllocator<U>& other) const noexcept { return !(*this == other); }
+
+private:
+    template <class U> friend class ConcurrentPoolAllocator;
+
+    std::shared_ptr<pool_detail::ConcurrentPoolState> state_;
+    pool_detail::ConcurrentSlab* slab_ = nullptr;
+
+    static constexpr size_type stride =
+        pool_detail::slot_stride(std::max(sizeof(T), pool_detail::CentralFreeList::min_stride), alignof(T));
+    static constexpr size_type align = pool_detail::slot_align(alignof(T));
+
+    pool_detail::ConcurrentSlab* slab() {
+        if (!slab_) slab_ = state_->pool_for(stride, align);
+        return slab_;
+    }
+};
@@ -0,0 +1,289 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "poolAllocator.hpp"
+
+// 多生产者只追加序列：多个线程同时 push_back，读者可以同时遍历已发布的前缀。
+// - 写入位置用 CAS 领取（先确保所在的段已分配），领到之后各自构造，互不等待；
+// - 存储分成若干段，第 k 段有 first_segment << k 个元素，段地址记在固定大小的段表里，
+//   扩容只是挂上新的一段，已有元素从不搬迁，地址在序列生命期内不变；
+// - 每个槽位有一个就绪标志；size() 是“已发布前缀”的长度：从头开始所有元素都已构造完成的最长一段。
+//   任何线程（生产者写完、读者查询）都会顺手把这个前缀往前推；
+// - 分配新段时加锁（段的数量是 log 级的），分配器本身不必是线程安全的，所以默认用 PoolAllocator；
+// - T 的构造函数抛异常时，异常传给调用者，该槽位不会被发布，已发布前缀停在它前面；
+//   分配新段失败（如 bad_alloc）发生在领取位置之前，异常传给调用者，序列不受影响。
+// clear() 和析构不能与其他操作并发。
+
+template <typename T, typename Alloc = PoolAllocator<T>>
+class ConcurrentSeq {
+    using alloc_traits = std::allocator_traits<Alloc>;
+    using flag_type = std::atomic<unsigned char>;
+    using flag_alloc = typename alloc_traits::template rebind_alloc<flag_type>;
+    using flag_traits = std::allocator_traits<flag_alloc>;
+
+    enum : unsigned char { slot_empty = 0, slot_ready = 1, slot_failed = 2 };
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    // 第 0 段的元素个数（2 的幂，约 4KB）
+    static constexpr size_type first_segment_shift = sizeof(T) >= 4096 ? 0 : sizeof(T) >= 2048 ? 1
+                                                    : sizeof(T) >= 1024 ? 2 : sizeof(T) >= 512 ? 3
+                                                    : sizeof(T) >= 256 ? 4 : sizeof(T) >= 128 ? 5 : 6;
+    static constexpr size_type first_segment = size_type(1) << first_segment_shift;
+    static constexpr size_type max_segments = 64 - first_segment_shift;
+
+    // 已发布前缀上的随机访问迭代器；end() 取的是调用时的 size()
+    template <bool Const>
+    class basic_iterator {
+        using seq_ptr = std::conditional_t<Const, const ConcurrentSeq*, ConcurrentSeq*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+
+        basic_iterator() noexcept = default;
+        template <bool C, class = std::enable_if_t<Const && !C>>
+        basic_iterator(const basic_iterator<C>& other) noexcept : seq_(other.seq_), i_(other.i_) {}
+
+        reference operator*() const noexcept { return seq_->slot(i_); }
+        pointer operator->() const noexcept { return &seq_->slot(i_); }
+        reference operator[](difference_type n) const noexcept { return seq_->slot(i_ + n); }
+
+        basic_iterator& operator++() noexcept { ++i_; return *this; }
+        basic_iterator operator++(int) noexcept { basic_iterator t = *this; ++i_; return t; }
+        basic_iterator& operator--() noexcept { --i_; return *this; }
+        basic_iterator operator--(int) noexcept { basic_iterator t = *this; --i_; return t; }
+        basic_iterator& operator+=(difference_type n) noexcept { i_ += n; return *this; }
+        basic_iterator& operator-=(difference_type n) noexcept { i_ -= n; return *this; }
+        friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+        friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+        friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept {
+            return static_cast<difference_type>(a.i_) - static_cast<difference_type>(b.i_);
+        }
+
+        friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.i_ == b.i_; }
+        friend bool operator!=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.i_ != b.i_; }
+        friend bool operator<(const basic_iterator& a, const basic_iterator& b) noexcept { return a.i_ < b.i_; }
+        friend bool operator>(const basic_iterator& a, const basic_iterator& b) noexcept { return a.i_ > b.i_; }
+        friend bool operator<=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.i_ <= b.i_; }
+        friend bool operator>=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.i_ >= b.i_; }
+
+    private:
+        friend class ConcurrentSeq;
+        template <bool> friend class basic_iterator;
+
+        seq_ptr seq_ = nullptr;
+        size_type i_ = 0;
+
+        basic_iterator(seq_ptr seq, size_type i) noexcept : seq_(seq), i_(i) {}
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    explicit ConcurrentSeq(const Alloc& alloc = Alloc()) : alloc_(alloc) {}
+
+    ConcurrentSeq(const ConcurrentSeq&) = delete;
+    ConcurrentSeq& operator=(const ConcurrentSeq&) = delete;
+
+    ~ConcurrentSeq() {
+        clear();
+        for (size_type k = 0; k < max_segments; ++k) free_segment(k);
+    }
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    // 追加一个元素，返回它的下标；可以在任意多个线程里同时调用
+    template <class... Args>
+    size_type emplace_back(Args&&... args) {
+        size_type i = claimed_.load(std::memory_order_relaxed);
+        size_type k;
+        Segment seg;
+        // 先保证段存在再领取位置：分配新段抛异常时什么都没领取，不会留下永远不发布的槽位
+        do {
+            k = segment_of(i);
+            seg = ensure_segment(k);
+        } while (!claimed_.compare_exchange_weak(i, i + 1, std::memory_order_relaxed));
+        size_type off = i - segment_start(k);
+        try {
+            alloc_traits::construct(alloc_, seg.data + off, std::forward<Args>(args)...);
+        } catch (...) {
+            seg.flags[off].store(slot_failed, std::memory_order_release);
+            throw;
+        }
+        seg.flags[off].store(slot_ready, std::memory_order_release);
+        // 前面的都发布了才需要推；漏推也没关系，size() 每次都会从 published_ 往后扫
+        if (published_.load(std::memory_order_relaxed) == i) advance();
+        return i;
+    }
+
+    size_type push_back(const T& v) { return emplace_back(v); }
+    size_type push_back(T&& v) { return emplace_back(std::move(v)); }
+
+    // 已发布前缀的长度：[0, size()) 里的元素都构造完成、对调用线程可见
+    size_type size() const noexcept { return advance(); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // 已领取的位置数（包括还在构造中的）
+    size_type claimed() const noexcept { return claimed_.load(std::memory_order_relaxed); }
+
+    // 已分配的槽位总数
+    size_type capacity() const noexcept {
+        size_type n = 0;
+        for (size_type k = 0; k < max_segments; ++k)
+            if (segments_[k].data.load(std::memory_order_acquire)) n += segment_size(k);
+        return n;
+    }
+
+    // 预先分配足够放下 n 个元素的段
+    void reserve(size_type n) {
+        if (n == 0) return;
+        for (size_type k = 0, last = segment_of(n - 1); k <= last; ++k) ensure_segment(k);
+    }
+
+    // 只能访问 i < size() 的元素
+    T& operator[](size_type i) noexcept { return slot(i); }
+    const T& operator[](size_type i) const noexcept { return slot(i); }
+
+    iterator begin() noexcept { return {this, 0}; }
+    iterator end() noexcept { return {this, size()}; }
+    const_iterator begin() const noexcept { return {this, 0}; }
+    const_iterator end() const noexcept { return {this, size()}; }
+
+    // 按段遍历已发布前缀：f(first, last) 对每段连续内存调用一次
+    template <class F>
+    void for_each_segment(F&& f) const {
+        size_type n = size();
+        for (size_type k = 0; k < max_segments && segment_start(k) < n; ++k) {
+            const T* data = segments_[k].data.load(std::memory_order_acquire);
+            size_type len = std::min(segment_size(k), n - segment_start(k));
+            f(data, data + len);
+        }
+    }
+
+    // 销毁所有元素，保留已分配的段；不能与其他操作并发
+    void clear() noexcept {
+        size_type n = claimed_.load(std::memory_order_relaxed);
+        for (size_type k = 0; k < max_segments && segment_start(k) < n; ++k) {
+            Segment seg = segments_[k].view();
+            if (!seg.data) continue;
+            size_type len = std::min(segment_size(k), n - segment_start(k));
+            for (size_type j = 0; j < len; ++j) {
+                if (seg.flags[j].load(std::memory_order_relaxed) == slot_ready) alloc_traits::destroy(alloc_, seg.data + j);
+                seg.flags[j].store(slot_empty, std::memory_order_relaxed);
+            }
+        }
+        claimed_.store(0, std::memory_order_relaxed);
+        published_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct Segment {
+        T* data;
+        flag_type* flags;
+    };
+
+    // 段表项：data 是发布用的原子指针，flags 在 data 发布之前写好
+    struct SegmentSlot {
+        std::atomic<T*> data{nullptr};
+        flag_type* flags = nullptr;
+
+        Segment view() const noexcept { return {data.load(std::memory_order_acquire), flags}; }
+    };
+
+    mutable Alloc alloc_;
+    std::atomic<size_type> claimed_{0};
+    mutable std::atomic<size_type> published_{0};
+    std::mutex grow_mutex_;
+    SegmentSlot segments_[max_segments];
+
+    static size_type log2_floor(size_type v) noexcept { return pool_detail::highest_set_bit(v); }
+
+    // 第 k 段覆盖 [first_segment * (2^k - 1), first_segment * (2^(k+1) - 1))
+    static size_type segment_of(size_type i) noexcept {
+        return log2_floor(i + first_segment) - first_segment_shift;
+    }
+    static constexpr size_type segment_start(size_type k) noexcept {
+        return ((size_type(1) << k) - 1) << first_segment_shift;
+    }
+    static constexpr size_type segment_size(size_type k) noexcept { return first_segment << k; }
+
+    T& slot(size_type i) const noexcept {
+        size_type k = segment_of(i);
+        return segments_[k].data.load(std::memory_order_relaxed)[i - segment_start(k)];
+    }
+
+    const flag_type* flag_of(size_type i) const noexcept {
+        size_type k = segment_of(i);
+        if (!segments_[k].data.load(std::memory_order_acquire)) return nullptr;
+        return segments_[k].flags + (i - segment_start(k));
+    }
+
+    Segment ensure_segment(size_type k) {
+        SegmentSlot& s = segments_[k];
+        if (!s.data.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(grow_mutex_);
+            if (!s.data.load(std::memory_order_relaxed)) {
+                size_type n = segment_size(k);
+                flag_alloc fa(alloc_);
+                flag_type* flags = flag_traits::allocate(fa, n);
+                for (size_type j = 0; j < n; ++j) ::new (static_cast<void*>(flags + j)) flag_type(slot_empty);
+                T* data;
+                try {
+                    data = alloc_traits::allocate(alloc_, n);
+                } catch (...) {
+                    flag_traits::deallocate(fa, flags, n);
+                    throw;
+                }
+                s.flags = flags;
+                s.data.store(data, std::memory_order_release);
+            }
+        }
+        return s.view();
+    }
+
+    void free_segment(size_type k) noexcept {
+        SegmentSlot& s = segments_[k];
+        T* data = s.data.load(std::memory_order_relaxed);
+        if (!data) return;
+        size_type n = segment_size(k);
+        alloc_traits::deallocate(alloc_, data, n);
+        flag_alloc fa(alloc_);
+        flag_traits::deallocate(fa, s.flags, n);
+        s.data.store(nullptr, std::memory_order_relaxed);
+        s.flags = nullptr;
+    }
+
+    // 把已发布前缀推到第一个未就绪的槽位；返回推进后的长度
+    size_type advance() const noexcept {
+        size_type p = published_.load(std::memory_order_acquire);
+        size_type start = p;
+        size_type limit = claimed_.load(std::memory_order_acquire);
+        while (p < limit) {
+            const flag_type* f = flag_of(p);
+            if (!f || f->load(std::memory_order_acquire) != slot_ready) break;
+            ++p;
+        }
+        if (p == start) return p;
+        // 别的线程可能推得更远，只往前推
+        while (!published_.compare_exchange_weak(start, p, std::memory_order_acq_rel, std::memory_order_acquire))
+            if (start >= p) return start;
+        return p;
+    }
+};
@@ -0,0 +1,298 @@
+#pragma once
+#include <memory>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <algorithm>
+#include <stdexcept>
+#include "simpleSeq.hpp"
+
+// 有序数组实现的 map：键和值分别放在两个 SimpleSeq 里，按键升序排列。
+// - 查找是无分支的二分查找，只读键数组，一次查找只碰 log2(n) 个缓存行，
+//   不像红黑树每层都要追一次指针；十来个元素的查找表整个放得进几个缓存行；
+// - 单个 insert / erase 要挪动后面的元素，是 O(n) 的，适合读多写少的表；
+// - insert(first, last) 批量插入：先把新元素排序去重，再和已有元素一次归并，O(n + m log m)。
+// 分配器模板参数与 std::map 一样写 Alloc<pair<const K, V>>，内部 rebind 到 K 和 V；
+// 插入已存在的键时保留原值（与 std::map::insert 相同）。
+
+template <typename K, typename V, typename Compare = std::less<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class FlatMap {
+    using alloc_traits = std::allocator_traits<Alloc>;
+    using key_alloc = typename alloc_traits::template rebind_alloc<K>;
+    using mapped_alloc = typename alloc_traits::template rebind_alloc<V>;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using key_compare = Compare;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using key_container = SimpleSeq<K, key_alloc>;
+    using mapped_container = SimpleSeq<V, mapped_alloc>;
+
+    // 解引用得到 pair<const K&, V&>，键和值各在自己的数组里
+    template <bool Const>
+    class basic_iterator {
+        using mapped_ref = std::conditional_t<Const, const V&, V&>;
+        using mapped_ptr = std::conditional_t<Const, const V*, V*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<K, V>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const K&, mapped_ref>;
+
+        struct pointer {
+            reference ref;
+            const reference* operator->() const noexcept { return &ref; }
+        };
+
+        basic_iterator() noexcept = default;
+        template <bool C, class = std::enable_if_t<Const && !C>>
+        basic_iterator(const basic_iterator<C>& other) noexcept : key_(other.key_), value_(other.value_) {}
+
+        reference operator*() const noexcept { return {*key_, *value_}; }
+        pointer operator->() const noexcept { return {**this}; }
+        reference operator[](difference_type n) const noexcept { return {key_[n], value_[n]}; }
+
+        basic_iterator& operator++() noexcept { ++key_; ++value_; return *this; }
+        basic_iterator operator++(int) noexcept { basic_iterator t = *this; ++*this; return t; }
+        basic_iterator& operator--() noexcept { --key_; --value_; return *this; }
+        basic_iterator operator--(int) noexcept { basic_iterator t = *this; --*this; return t; }
+        basic_iterator& operator+=(difference_type n) noexcept { key_ += n; value_ += n; return *this; }
+        basic_iterator& operator-=(difference_type n) noexcept { key_ -= n; value_ -= n; return *this; }
+        friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+        friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+        friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept { return a.key_ - b.key_; }
+
+        friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.key_ == b.key_; }
+        friend bool operator!=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.key_ != b.key_; }
+        friend bool operator<(const basic_iterator& a, const basic_iterator& b) noexcept { return a.key_ < b.key_; }
+        friend bool operator>(const basic_iterator& a, const basic_iterator& b) noexcept { return a.key_ > b.key_; }
+        friend bool operator<=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.key_ <= b.key_; }
+        friend bool operator>=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.key_ >= b.key_; }
+
+        const K& key() const noexcept { return *key_; }
+        mapped_ref value() const noexcept { return *value_; }
+
+    private:
+        friend class FlatMap;
+        template <bool> friend class basic_iterator;
+
+        const K* key_ = nullptr;
+        mapped_ptr value_ = nullptr;
+
+        basic_iterator(const K* key, mapped_ptr value) noexcept : key_(key), value_(value) {}
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    explicit FlatMap(const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+        : comp_(comp), keys_(0, key_alloc(alloc)), values_(0, mapped_alloc(alloc)) {}
+
+    explicit FlatMap(const Alloc& alloc) : FlatMap(Compare(), alloc) {}
+
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    FlatMap(It first, It last, const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+        : FlatMap(comp, alloc) {
+        insert(first, last);
+    }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(keys_.get_allocator()); }
+    key_compare key_comp() const { return comp_; }
+
+    size_type size() const noexcept { return keys_.size(); }
+    bool empty() const noexcept { return keys_.empty(); }
+    size_type capacity() const noexcept { return keys_.capacity(); }
+
+    // 直接访问按键排好序的两个数组
+    const key_container& keys() const noexcept { return keys_; }
+    const mapped_container& values() const noexcept { return values_; }
+
+    iterator begin() noexcept { return {keys_.data(), values_.data()}; }
+    iterator end() noexcept { return {keys_.data() + size(), values_.data() + size()}; }
+    const_iterator begin() const noexcept { return {keys_.data(), values_.data()}; }
+    const_iterator end() const noexcept { return {keys_.data() + size(), values_.data() + size()}; }
+
+    void reserve(size_type n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+
+    void clear() noexcept {
+        keys_.clear();
+        values_.clear();
+    }
+
+    iterator lower_bound(const K& key) noexcept { return at_index(lower_index(key)); }
+    const_iterator lower_bound(const K& key) const noexcept { return at_index(lower_index(key)); }
+
+    iterator find(const K& key) noexcept { return at_index(find_index(key)); }
+    const_iterator find(const K& key) const noexcept { return at_index(find_index(key)); }
+
+    bool contains(const K& key) const noexcept { return find_index(key) != size(); }
+    size_type count(const K& key) const noexcept { return contains(key) ? 1 : 0; }
+
+    V& at(const K& key) {
+        size_type i = find_index(key);
+        if (i == size()) throw std::out_of_range("FlatMap::at: key not found");
+        return values_[i];
+    }
+    const V& at(const K& key) const {
+        size_type i = find_index(key);
+        if (i == size()) throw std::out_of_range("FlatMap::at: key not found");
+        return values_[i];
+    }
+
+    V& operator[](const K& key) {
+        return try_emplace(key).first.value();
+    }
+
+    // 键不存在时用 args 构造值插入
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        size_type i = lower_index(key);
+        if (i != size() && !comp_(key, keys_[i])) return {at_index(i), false};
+        insert_at(i, key, V(std::forward<Args>(args)...));
+        return {at_index(i), true};
+    }
+
+    std::pair<iterator, bool> insert(const K& key, const V& value) {
+        return try_emplace(key, value);
+    }
+
+    std::pair<iterator, bool> insert_or_assign(const K& key, const V& value) {
+        auto r = try_emplace(key, value);
+        if (!r.second) r.first.value() = value;
+        return r;
+    }
+
+    // 批量插入 pair<K, V>（或可以用 .first / .second 访问的类型）
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    void insert(It first, It last) {
+        using entry = std::pair<K, V>;
+        using entry_alloc = typename alloc_traits::template rebind_alloc<entry>;
+        SimpleSeq<entry, entry_alloc> batch(0, entry_alloc(keys_.get_allocator()));
+        if constexpr (seq_detail::is_forward_iterator<It>)
+            batch.reserve(static_cast<size_type>(std::distance(first, last)));
+        for (; first != last; ++first) batch.emplace_back(first->first, first->second);
+        if (batch.empty()) return;
+
+        // 同一批里重复的键保留第一个，和逐个 insert 的结果一致
+        std::stable_sort(batch.begin(), batch.end(),
+                         [this](const entry& a, const entry& b) { return comp_(a.first, b.first); });
+        auto unique_end = std::unique(batch.begin(), batch.end(), [this](const entry& a, const entry& b) {
+            return !comp_(a.first, b.first) && !comp_(b.first, a.first);
+        });
+        merge_sorted(batch.begin(), unique_end);
+    }
+
+    template <class Range>
+    void insert_range(Range&& r) {
+        using std::begin;
+        using std::end;
+        insert(begin(r), end(r));
+    }
+
+    size_type erase(const K& key) {
+        size_type i = find_index(key);
+        if (i == size()) return 0;
+        erase_at(i);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos) {
+        size_type i = static_cast<size_type>(pos.key_ - keys_.data());
+        erase_at(i);
+        return at_index(i);
+    }
+
+private:
+    Compare comp_;
+    key_container keys_;
+    mapped_container values_;
+
+    iterator at_index(size_type i) noexcept { return {keys_.data() + i, values_.data() + i}; }
+    const_iterator at_index(size_type i) const noexcept { return {keys_.data() + i, values_.data() + i}; }
+
+    // 无分支二分：每轮只根据一次比较移动 base，循环次数固定为 log2(n)，
+    // 编译器生成 cmov 而不是难以预测的跳转
+    size_type lower_index(const K& key) const noexcept {
+        size_type n = keys_.size();
+        if (n == 0) return 0;
+        const K* base = keys_.data();
+        while (n > 1) {
+            size_type half = n / 2;
+            base = comp_(base[half], key) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<size_type>(base - keys_.data()) + (comp_(*base, key) ? 1 : 0);
+    }
+
+    size_type find_index(const K& key) const noexcept {
+        size_type i = lower_index(key);
+        if (i != size() && !comp_(key, keys_[i])) return i;
+        return size();
+    }
+
+    void insert_at(size_type i, const K& key, V&& value) {
+        const K* k = &key;
+        V* v = &value;
+        keys_.insert(keys_.begin() + i, k, k + 1);
+        try {
+            values_.insert(values_.begin() + i, std::make_move_iterator(v), std::make_move_iterator(v + 1));
+        } catch (...) {
+            // 两个数组必须一样长：把刚插进去的键退掉
+            std::rotate(keys_.begin() + i, keys_.begin() + i + 1, keys_.end());
+            keys_.pop_back();
+            throw;
+        }
+    }
+
+    void erase_at(size_type i) {
+        std::move(keys_.begin() + i + 1, keys_.end(), keys_.begin() + i);
+        keys_.pop_back();
+        std::move(values_.begin() + i + 1, values_.end(), values_.begin() + i);
+        values_.pop_back();
+    }
+
+    // 已有元素在归并时搬到新数组：键和值的移动都不抛异常才移动，否则拷贝，
+    // 这样中途抛异常时原来的数组原封不动（与 std::move_if_noexcept 同理，但键值一起判断）
+    static constexpr bool nothrow_merge =
+        std::is_nothrow_move_constructible<K>::value && std::is_nothrow_move_constructible<V>::value;
+
+    template <class T>
+    using merge_source_t =
+        std::conditional_t<nothrow_merge || !std::is_copy_constructible<T>::value, T&&, const T&>;
+
+    // 把已排序、无重复的 [first, last) 归并进来：只分配一次新数组，已有的键优先；
+    // [first, last) 是 insert 的临时数组，直接移走
+    template <class It>
+    void merge_sorted(It first, It last) {
+        size_type m = static_cast<size_type>(last - first);
+        key_container keys(0, keys_.get_allocator());
+        mapped_container values(0, values_.get_allocator());
+        keys.reserve(size() + m);
+        values.reserve(size() + m);
+        size_type i = 0, n = size();
+        while (i < n || first != last) {
+            if (first == last || (i < n && !comp_(first->first, keys_[i]))) {
+                if (first != last && !comp_(keys_[i], first->first)) ++first;
+                keys.push_back(static_cast<merge_source_t<K>>(keys_[i]));
+                values.push_back(static_cast<merge_source_t<V>>(values_[i]));
+                ++i;
+            } else {
+                keys.push_back(std::move(first->first));
+                values.push_back(std::move(first->second));
+                ++first;
+            }
+        }
+        keys_ = std::move(keys);
+        values_ = std::move(values);
+    }
+};
@@ -0,0 +1,555 @@
+#pragma once
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <tuple>
+#include <functional>
+#include <type_traits>
+#include <algorithm>
+#include <stdexcept>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POOL_HASHMAP_SSE2 1
+#else
+#define POOL_HASHMAP_SSE2 0
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "simpleSeq.hpp"
+
+// 开放寻址哈希表（SwissTable 的做法）：元素直接放在一个连续的槽位数组里，
+// 每个槽位配一个控制字节：空、已删除，或者哈希值的低 7 位（H2）。
+// - 查找时一次读 16 个控制字节，用 SSE2 一条比较指令找出 H2 相同的候选槽，
+//   只有候选槽才真正比较键；没有 SSE2 时退回逐字节比较，语义相同；
+// - 槽位按组做三角探测，容量是 2^k - 1，负载上限 7/8；
+// - 槽位数组和控制字节放在同一次分配里，只有 rehash 时才向分配器要内存，
+//   不像 std::unordered_map 每个元素一个节点；
+// - 分配器写法与 std::unordered_map 相同（Alloc<pair<const K, V>>），
+//   PoolAllocator、polymorphic_allocator（PoolResource）都能用。
+// 删除只留下墓碑，墓碑在下一次 rehash 时清掉；插入和 rehash 会使迭代器和引用失效。
+
+namespace hash_detail {
+
+using ctrl_t = signed char;
+
+constexpr ctrl_t ctrl_empty = -128;
+constexpr ctrl_t ctrl_deleted = -2;
+constexpr ctrl_t ctrl_sentinel = -1;
+constexpr std::size_t group_width = 16;
+
+// std::hash<int> 往往是恒等映射，先打散一下再拆成 H1 / H2（murmur3 的 fmix64）
+inline std::size_t mix(std::size_t h) noexcept {
+    std::uint64_t x = h;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<std::size_t>(x);
+}
+
+inline unsigned lowest_bit(std::uint32_t x) noexcept {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return static_cast<unsigned>(i);
+#else
+    return static_cast<unsigned>(__builtin_ctz(x));
+#endif
+}
+
+// 一组 16 个控制字节里命中的位置，按从低到高的顺序取出
+class BitMask {
+public:
+    explicit BitMask(std::uint32_t bits) noexcept : bits_(bits) {}
+    explicit operator bool() const noexcept { return bits_ != 0; }
+    unsigned next() noexcept {
+        unsigned i = lowest_bit(bits_);
+        bits_ &= bits_ - 1;
+        return i;
+    }
+
+private:
+    std::uint32_t bits_;
+};
+
+class Group {
+public:
+    explicit Group(const ctrl_t* p) noexcept {
+#if POOL_HASHMAP_SSE2
+        v_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+#else
+        std::memcpy(c_, p, group_width);
+#endif
+    }
+
+    BitMask match(ctrl_t h2) const noexcept {
+#if POOL_HASHMAP_SSE2
+        return BitMask(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), v_))));
+#else
+        return scan([h2](ctrl_t c) { return c == h2; });
+#endif
+    }
+
+    BitMask match_empty() const noexcept { return match(ctrl_empty); }
+
+    // 空槽和墓碑都小于哨兵 -1
+    BitMask match_empty_or_deleted() const noexcept {
+#if POOL_HASHMAP_SSE2
+        return BitMask(static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), v_))));
+#else
+        return scan([](ctrl_t c) { return c < ctrl_sentinel; });
+#endif
+    }
+
+private:
+#if POOL_HASHMAP_SSE2
+    __m128i v_;
+#else
+    ctrl_t c_[group_width];
+
+    template <class P>
+    BitMask scan(P pred) const noexcept {
+        std::uint32_t bits = 0;
+        for (std::size_t i = 0; i < group_width; ++i)
+            bits |= std::uint32_t(pred(c_[i])) << i;
+        return BitMask(bits);
+    }
+#endif
+};
+
+} // namespace hash_detail
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class HashMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+
+private:
+    using ctrl_t = hash_detail::ctrl_t;
+    using slot_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<value_type>;
+    using alloc_traits = std::allocator_traits<slot_alloc>;
+
+    static constexpr size_type group_width = hash_detail::group_width;
+    static constexpr size_type min_capacity = group_width - 1;
+    static constexpr size_type npos = ~size_type(0);
+
+    // 键和值都可平凡拷贝时 rehash 直接 memcpy 槽位
+    static constexpr bool memcpy_slots =
+        std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value;
+
+public:
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = HashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+        basic_iterator() noexcept = default;
+        template <bool C, class = std::enable_if_t<Const && !C>>
+        basic_iterator(const basic_iterator<C>& other) noexcept : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+        reference operator*() const noexcept { return *slot_; }
+        pointer operator->() const noexcept { return slot_; }
+
+        basic_iterator& operator++() noexcept {
+            ++ctrl_;
+            ++slot_;
+            skip_empty();
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            basic_iterator t = *this;
+            ++*this;
+            return t;
+        }
+
+        friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a.slot_ == b.slot_; }
+        friend bool operator!=(const basic_iterator& a, const basic_iterator& b) noexcept { return a.slot_ != b.slot_; }
+
+    private:
+        friend class HashMap;
+        template <bool> friend class basic_iterator;
+
+        const ctrl_t* ctrl_ = nullptr;
+        pointer slot_ = nullptr;
+
+        basic_iterator(const ctrl_t* ctrl, pointer slot) noexcept : ctrl_(ctrl), slot_(slot) {}
+
+        // 控制字节末尾有哨兵，走到哨兵就是 end()
+        void skip_empty() noexcept {
+            while (*ctrl_ < hash_detail::ctrl_sentinel) {
+                ++ctrl_;
+                ++slot_;
+            }
+        }
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    explicit HashMap(size_type reserve_count = 0, const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual(),
+                     const Alloc& alloc = Alloc())
+        : hash_(hash), eq_(eq), alloc_(alloc) {
+        if (reserve_count > 0) {
+            reserve(reserve_count);
+        }
+    }
+
+    explicit HashMap(const Alloc& alloc) : HashMap(0, Hash(), KeyEqual(), alloc) {}
+
+    HashMap(const HashMap& other)
+        : hash_(other.hash_), eq_(other.eq_),
+          alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_)) {
+        guarded([&] { copy_from(other); });
+    }
+
+    HashMap(HashMap&& other) noexcept
+        : hash_(std::move(other.hash_)), eq_(std::move(other.eq_)), alloc_(std::move(other.alloc_)) {
+        steal(other);
+    }
+
+    ~HashMap() {
+        release();
+    }
+
+    HashMap& operator=(const HashMap& other) {
+        if (this == &other) return *this;
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) release();
+            alloc_ = other.alloc_;
+        }
+        hash_ = other.hash_;
+        eq_ = other.eq_;
+        clear();
+        copy_from(other);
+        return *this;
+    }
+
+    HashMap& operator=(HashMap&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value) {
+        if (this == &other) return *this;
+        hash_ = std::move(other.hash_);
+        eq_ = std::move(other.eq_);
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+            release();
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                release();
+                steal(other);
+            } else {
+                // 分配器不相等又不能传播：只能逐个移动元素
+                clear();
+                reserve(other.size_);
+                for (auto& kv : other) try_emplace(kv.first, std::move(kv.second));
+                other.release();
+            }
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(alloc_); }
+    hasher hash_function() const { return hash_; }
+    key_equal key_eq() const { return eq_; }
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_type capacity() const noexcept { return capacity_; }
+    float load_factor() const noexcept { return capacity_ ? float(size_) / float(capacity_) : 0.0f; }
+
+    iterator begin() noexcept { return first_full<iterator>(); }
+    iterator end() noexcept { return {ctrl_ + capacity_, slots_ + capacity_}; }
+    const_iterator begin() const noexcept { return first_full<const_iterator>(); }
+    const_iterator end() const noexcept { return {ctrl_ + capacity_, slots_ + capacity_}; }
+
+    iterator find(const K& key) { return at_index(find_index(key, hash_of(key))); }
+    const_iterator find(const K& key) const { return at_index(find_index(key, hash_of(key))); }
+
+    bool contains(const K& key) const { return find_index(key, hash_of(key)) != npos; }
+    size_type count(const K& key) const { return contains(key) ? 1 : 0; }
+
+    V& at(const K& key) {
+        size_type i = find_index(key, hash_of(key));
+        if (i == npos) throw std::out_of_range("HashMap::at: key not found");
+        return slots_[i].second;
+    }
+    const V& at(const K& key) const {
+        size_type i = find_index(key, hash_of(key));
+        if (i == npos) throw std::out_of_range("HashMap::at: key not found");
+        return slots_[i].second;
+    }
+
+    V& operator[](const K& key) { return try_emplace(key).first->second; }
+    V& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+    // 键不存在时用 args 构造值插入；键已存在时什么也不构造
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        return emplace_key(key, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        return emplace_key(std::move(key), std::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& kv) { return emplace_key(kv.first, kv.second); }
+    std::pair<iterator, bool> insert(value_type&& kv) { return emplace_key(kv.first, std::move(kv.second)); }
+
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    void insert(It first, It last) {
+        if constexpr (seq_detail::is_forward_iterator<It>)
+            reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+        for (; first != last; ++first) emplace_key(first->first, first->second);
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const K& key, M&& value) {
+        auto r = emplace_key(key, std::forward<M>(value));
+        if (!r.second) r.first->second = std::forward<M>(value);
+        return r;
+    }
+
+    size_type erase(const K& key) {
+        size_type i = find_index(key, hash_of(key));
+        if (i == npos) return 0;
+        erase_index(i);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos) {
+        size_type i = static_cast<size_type>(pos.slot_ - slots_);
+        erase_index(i);
+        iterator next(ctrl_ + i, slots_ + i);
+        next.skip_empty();
+        return next;
+    }
+
+    // 保证再插入到 n 个元素之前不会 rehash
+    void reserve(size_type n) {
+        if (n <= growth_limit(capacity_)) return;
+        resize(capacity_for(n));
+    }
+
+    void clear() noexcept {
+        if (capacity_ == 0) return;
+        destroy_all();
+        reset_ctrl();
+        size_ = 0;
+        growth_left_ = growth_limit(capacity_);
+    }
+
+private:
+    Hash hash_;
+    KeyEqual eq_;
+    slot_alloc alloc_;
+    value_type* slots_ = nullptr;
+    ctrl_t* ctrl_ = nullptr;
+    size_type capacity_ = 0;
+    size_type size_ = 0;
+    // 还能往空槽里放多少个元素；墓碑不计入
+    size_type growth_left_ = 0;
+
+    static size_type growth_limit(size_type cap) noexcept { return cap - cap / 8; }
+
+    static size_type capacity_for(size_type n) noexcept {
+        size_type cap = min_capacity;
+        while (growth_limit(cap) < n) cap = cap * 2 + 1;
+        return cap;
+    }
+
+    // 槽位后面紧跟控制字节：cap 个 + 哨兵 + 为跨尾读取复制的前 15 个
+    static size_type units_for(size_type cap) noexcept {
+        return cap + (cap + group_width + sizeof(value_type) - 1) / sizeof(value_type);
+    }
+
+    size_type hash_of(const K& key) const { return hash_detail::mix(hash_(key)); }
+    static ctrl_t h2(size_type hash) noexcept { return static_cast<ctrl_t>(hash & 0x7f); }
+    static size_type h1(size_type hash) noexcept { return hash >> 7; }
+
+    iterator at_index(size_type i) noexcept {
+        return i == npos ? end() : iterator(ctrl_ + i, slots_ + i);
+    }
+    const_iterator at_index(size_type i) const noexcept {
+        return i == npos ? end() : const_iterator(ctrl_ + i, slots_ + i);
+    }
+
+    template <class It>
+    It first_full() const noexcept {
+        if (capacity_ == 0) return It();
+        It it(ctrl_, slots_);
+        it.skip_empty();
+        return it;
+    }
+
+    // 同时写入尾部的镜像字节，使从任意位置开始读 16 个字节都不用绕回
+    void set_ctrl(size_type i, ctrl_t c) noexcept {
+        ctrl_[i] = c;
+        ctrl_[((i - (group_width - 1)) & capacity_) + (group_width - 1)] = c;
+    }
+
+    void reset_ctrl() noexcept {
+        std::memset(ctrl_, static_cast<unsigned char>(hash_detail::ctrl_empty), capacity_ + group_width);
+        ctrl_[capacity_] = hash_detail::ctrl_sentinel;
+    }
+
+    size_type find_index(const K& key, size_type hash) const {
+        if (size_ == 0) return npos;
+        size_type offset = h1(hash) & capacity_;
+        for (size_type step = group_width;; step += group_width) {
+            hash_detail::Group g(ctrl_ + offset);
+            for (auto m = g.match(h2(hash)); m;) {
+                size_type i = (offset + m.next()) & capacity_;
+                if (eq_(slots_[i].first, key)) return i;
+            }
+            if (g.match_empty()) return npos;
+            offset = (offset + step) & capacity_;
+        }
+    }
+
+    // 第一个空槽或墓碑；负载上限保证一定找得到
+    size_type find_free(size_type hash) const noexcept {
+        size_type offset = h1(hash) & capacity_;
+        for (size_type step = group_width;; step += group_width) {
+            hash_detail::Group g(ctrl_ + offset);
+            if (auto m = g.match_empty_or_deleted()) return (offset + m.next()) & capacity_;
+            offset = (offset + step) & capacity_;
+        }
+    }
+
+    template <class KArg, class... Args>
+    std::pair<iterator, bool> emplace_key(KArg&& key, Args&&... args) {
+        size_type hash = hash_of(key);
+        size_type i = find_index(key, hash);
+        if (i != npos) return {iterator(ctrl_ + i, slots_ + i), false};
+        if (capacity_ == 0) resize(min_capacity);
+        i = find_free(hash);
+        if (growth_left_ == 0 && ctrl_[i] != hash_detail::ctrl_deleted) {
+            rehash_and_grow();
+            i = find_free(hash);
+        }
+        alloc_traits::construct(alloc_, slots_ + i, std::piecewise_construct,
+                                std::forward_as_tuple(std::forward<KArg>(key)),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+        if (ctrl_[i] == hash_detail::ctrl_empty) --growth_left_;
+        set_ctrl(i, h2(hash));
+        ++size_;
+        return {iterator(ctrl_ + i, slots_ + i), true};
+    }
+
+    // 墓碑占了一半以上的可用空间时原容量重建，否则翻倍
+    void rehash_and_grow() {
+        if (size_ <= growth_limit(capacity_) / 2) resize(capacity_);
+        else resize(capacity_ * 2 + 1);
+    }
+
+    void erase_index(size_type i) {
+        alloc_traits::destroy(alloc_, slots_ + i);
+        set_ctrl(i, hash_detail::ctrl_deleted);
+        --size_;
+    }
+
+    // 换到容量为 new_cap 的新表。元素用 move_if_noexcept 搬，搬的过程中抛异常时旧表不变
+    void resize(size_type new_cap) {
+        size_type units = units_for(new_cap);
+        value_type* new_slots = alloc_traits::allocate(alloc_, units);
+        value_type* old_slots = slots_;
+        ctrl_t* old_ctrl = ctrl_;
+        size_type old_cap = capacity_;
+
+        slots_ = new_slots;
+        ctrl_ = reinterpret_cast<ctrl_t*>(new_slots + new_cap);
+        capacity_ = new_cap;
+        reset_ctrl();
+        size_type moved = 0;
+        try {
+            for (size_type j = 0; j < old_cap; ++j) {
+                if (old_ctrl[j] < hash_detail::ctrl_sentinel) continue;
+                size_type hash = hash_of(old_slots[j].first);
+                size_type i = find_free(hash);
+                if constexpr (memcpy_slots) {
+                    std::memcpy(static_cast<void*>(slots_ + i), static_cast<const void*>(old_slots + j),
+                                sizeof(value_type));
+                } else {
+                    alloc_traits::construct(alloc_, slots_ + i, std::move_if_noexcept(old_slots[j]));
+                }
+                set_ctrl(i, h2(hash));
+                ++moved;
+            }
+        } catch (...) {
+            if (moved) destroy_all();
+            alloc_traits::deallocate(alloc_, new_slots, units);
+            slots_ = old_slots;
+            ctrl_ = old_ctrl;
+            capacity_ = old_cap;
+            throw;
+        }
+        if (old_slots) {
+            if constexpr (!memcpy_slots) {
+                for (size_type j = 0; j < old_cap; ++j)
+                    if (old_ctrl[j] >= 0) alloc_traits::destroy(alloc_, old_slots + j);
+            }
+            alloc_traits::deallocate(alloc_, old_slots, units_for(old_cap));
+        }
+        growth_left_ = growth_limit(new_cap) - size_;
+    }
+
+    void destroy_all() noexcept {
+        if constexpr (!std::is_trivially_destructible<value_type>::value) {
+            for (size_type i = 0; i < capacity_; ++i)
+                if (ctrl_[i] >= 0) alloc_traits::destroy(alloc_, slots_ + i);
+        }
+    }
+
+    template <class F>
+    void guarded(F&& fill) {
+        try {
+            fill();
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    void copy_from(const HashMap& other) {
+        reserve(other.size_);
+        for (const auto& kv : other) emplace_key(kv.first, kv.second);
+    }
+
+    void release() noexcept {
+        if (capacity_ == 0) return;
+        destroy_all();
+        alloc_traits::deallocate(alloc_, slots_, units_for(capacity_));
+        slots_ = nullptr;
+        ctrl_ = nullptr;
+        capacity_ = size_ = growth_left_ = 0;
+    }
+
+    void steal(HashMap& other) noexcept {
+        slots_ = other.slots_;
+        ctrl_ = other.ctrl_;
+        capacity_ = other.capacity_;
+        size_ = other.size_;
+        growth_left_ = other.growth_left_;
+        other.slots_ = nullptr;
+        other.ctrl_ = nullptr;
+        other.capacity_ = other.size_ = other.growth_left_ = 0;
+    }
+};
@@ -0,0 +1,278 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "simpleSeq.hpp"
+
+// 元素直接放在对象内部、容量固定为 N 的顺序容器，接口与 SimpleSeq 一致，但从不分配内存。
+// - 超出容量的 push_back / emplace_back / resize 抛 std::length_error；
+//   实时路径上用 try_push_back / try_emplace_back，满了返回 false / nullptr，不抛异常；
+// - T 是平凡类型（int、POD 结构体）时存储就是 T[N]，所有成员函数都是 constexpr，
+//   可以在常量表达式里构造和修改，整个对象也是平凡可拷贝的；
+// - 其他 T 用对齐的字节数组加 placement new，元素按需构造和析构。
+// reserve() / shrink_to_fit() 只为与 SimpleSeq 兼容，reserve 超过 N 时抛 std::length_error。
+
+namespace seq_detail {
+
+template <class T>
+constexpr bool is_inplace_trivial = std::is_trivially_default_constructible<T>::value &&
+                                    std::is_trivially_copyable<T>::value &&
+                                    std::is_trivially_destructible<T>::value;
+
+[[noreturn]] inline void throw_inplace_full() { throw std::length_error("InplaceSeq: capacity exceeded"); }
+
+template <class T, std::size_t N, bool Trivial = is_inplace_trivial<T>>
+class InplaceStorage {
+protected:
+    T data_[N];
+    std::size_t size_;
+
+    constexpr InplaceStorage() noexcept : data_{}, size_(0) {}
+
+    constexpr T* ptr() noexcept { return data_; }
+    constexpr const T* ptr() const noexcept { return data_; }
+
+    template <class... Args>
+    constexpr T& construct_at(std::size_t i, Args&&... args) {
+        data_[i] = T(std::forward<Args>(args)...);
+        return data_[i];
+    }
+
+    constexpr void destroy_range(std::size_t, std::size_t) noexcept {}
+};
+
+// N 为 0 时没有元素存储
+template <class T>
+class InplaceStorage<T, 0, true> {
+protected:
+    std::size_t size_;
+
+    constexpr InplaceStorage() noexcept : size_(0) {}
+
+    constexpr T* ptr() noexcept { return nullptr; }
+    constexpr const T* ptr() const noexcept { return nullptr; }
+
+    template <class... Args>
+    constexpr T& construct_at(std::size_t, Args&&...) { throw_inplace_full(); }
+
+    constexpr void destroy_range(std::size_t, std::size_t) noexcept {}
+};
+
+template <class T, std::size_t N>
+class InplaceStorage<T, N, false> {
+protected:
+    alignas(T) unsigned char bytes_[N ? N * sizeof(T) : 1];
+    std::size_t size_ = 0;
+
+    InplaceStorage() noexcept = default;
+
+    InplaceStorage(const InplaceStorage& other) { copy_from(other); }
+
+    InplaceStorage(InplaceStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        for (; size_ < other.size_; ++size_) ::new (static_cast<void*>(ptr() + size_)) T(std::move(other.ptr()[size_]));
+    }
+
+    InplaceStorage& operator=(const InplaceStorage& other) {
+        if (this != &other) {
+            destroy_range(0, size_);
+            size_ = 0;
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    InplaceStorage& operator=(InplaceStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            destroy_range(0, size_);
+            size_ = 0;
+            for (; size_ < other.size_; ++size_)
+                ::new (static_cast<void*>(ptr() + size_)) T(std::move(other.ptr()[size_]));
+        }
+        return *this;
+    }
+
+    ~InplaceStorage() { destroy_range(0, size_); }
+
+    T* ptr() noexcept { return std::launder(reinterpret_cast<T*>(bytes_)); }
+    const T* ptr() const noexcept { return std::launder(reinterpret_cast<const T*>(bytes_)); }
+
+    template <class... Args>
+    T& construct_at(std::size_t i, Args&&... args) {
+        return *::new (static_cast<void*>(ptr() + i)) T(std::forward<Args>(args)...);
+    }
+
+    void destroy_range(std::size_t from, std::size_t to) noexcept {
+        for (std::size_t i = from; i < to; ++i) ptr()[i].~T();
+    }
+
+private:
+    // 任一元素拷贝失败时，已拷贝的部分由 size_ 记录，析构时照常销毁
+    void copy_from(const InplaceStorage& other) {
+        for (; size_ < other.size_; ++size_) ::new (static_cast<void*>(ptr() + size_)) T(other.ptr()[size_]);
+    }
+};
+
+} // namespace seq_detail
+
+template <typename T, std::size_t N>
+class InplaceSeq : private seq_detail::InplaceStorage<T, N> {
+    using base = seq_detail::InplaceStorage<T, N>;
+    using base::size_;
+    using base::ptr;
+    using base::construct_at;
+    using base::destroy_range;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    constexpr InplaceSeq() noexcept = default;
+
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    constexpr InplaceSeq(It first, It last) {
+        append(first, last);
+    }
+
+    constexpr InplaceSeq(std::initializer_list<T> init) { append(init.begin(), init.end()); }
+
+    constexpr void push_back(const T& v) { emplace_back(v); }
+    constexpr void push_back(T&& v) { emplace_back(std::move(v)); }
+
+    template <class... Args>
+    constexpr T& emplace_back(Args&&... args) {
+        if (size_ >= N) seq_detail::throw_inplace_full();
+        T& r = construct_at(size_, std::forward<Args>(args)...);
+        ++size_;
+        return r;
+    }
+
+    // 满了返回 nullptr，不抛异常
+    template <class... Args>
+    constexpr T* try_emplace_back(Args&&... args) {
+        if (size_ >= N) return nullptr;
+        T& r = construct_at(size_, std::forward<Args>(args)...);
+        ++size_;
+        return &r;
+    }
+
+    constexpr bool try_push_back(const T& v) { return try_emplace_back(v) != nullptr; }
+    constexpr bool try_push_back(T&& v) { return try_emplace_back(std::move(v)) != nullptr; }
+
+    constexpr void pop_back() noexcept {
+        --size_;
+        destroy_range(size_, size_ + 1);
+    }
+
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    constexpr void assign(It first, It last) {
+        clear();
+        append(first, last);
+    }
+
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    constexpr iterator insert(const_iterator pos, It first, It last) {
+        size_type offset = static_cast<size_type>(pos - ptr());
+        size_type old_size = size_;
+        append(first, last);
+        rotate_tail(offset, old_size);
+        return ptr() + offset;
+    }
+
+    template <class Range>
+    constexpr void append_range(Range&& r) {
+        using std::begin;
+        using std::end;
+        append(begin(r), end(r));
+    }
+
+    constexpr void resize(size_type n) {
+        if (n > N) seq_detail::throw_inplace_full();
+        if (n <= size_) {
+            destroy_tail(n);
+            return;
+        }
+        while (size_ < n) {
+            construct_at(size_);
+            ++size_;
+        }
+    }
+
+    constexpr void resize(size_type n, const T& v) {
+        if (n > N) seq_detail::throw_inplace_full();
+        if (n <= size_) {
+            destroy_tail(n);
+            return;
+        }
+        while (size_ < n) {
+            construct_at(size_, v);
+            ++size_;
+        }
+    }
+
+    constexpr size_type size() const noexcept { return size_; }
+    static constexpr size_type capacity() noexcept { return N; }
+    static constexpr size_type max_size() noexcept { return N; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr bool full() const noexcept { return size_ == N; }
+
+    constexpr T& operator[](size_type i) noexcept { return ptr()[i]; }
+    constexpr const T& operator[](size_type i) const noexcept { return ptr()[i]; }
+    constexpr T* data() noexcept { return ptr(); }
+    constexpr const T* data() const noexcept { return ptr(); }
+
+    constexpr iterator begin() noexcept { return ptr(); }
+    constexpr iterator end() noexcept { return ptr() + size_; }
+    constexpr const_iterator begin() const noexcept { return ptr(); }
+    constexpr const_iterator end() const noexcept { return ptr() + size_; }
+
+    constexpr void reserve(size_type new_cap) {
+        if (new_cap > N) seq_detail::throw_inplace_full();
+    }
+
+    constexpr void shrink_to_fit() noexcept {}
+
+    constexpr void clear() noexcept { destroy_tail(0); }
+
+private:
+    template <class It>
+    constexpr void append(It first, It last) {
+        if constexpr (seq_detail::is_forward_iterator<It>) {
+            if (static_cast<size_type>(std::distance(first, last)) > N - size_) seq_detail::throw_inplace_full();
+        }
+        for (; first != last; ++first) emplace_back(*first);
+    }
+
+    constexpr void destroy_tail(size_type n) noexcept {
+        destroy_range(n, size_);
+        size_ = n;
+    }
+
+    // 把 [old_size, size_) 挪到 offset 处；std::rotate 在 C++17 里不是 constexpr，平凡类型用三次反转
+    constexpr void rotate_tail(size_type offset, size_type old_size) {
+        if constexpr (seq_detail::is_inplace_trivial<T>) {
+            reverse(offset, old_size);
+            reverse(old_size, size_);
+            reverse(offset, size_);
+        } else {
+            std::rotate(ptr() + offset, ptr() + old_size, ptr() + size_);
+        }
+    }
+
+    constexpr void reverse(size_type first, size_type last) noexcept {
+        T* d = ptr();
+        for (; first + 1 < last; ++first, --last) {
+            T tmp = d[first];
+            d[first] = d[last - 1];
+            d[last - 1] = tmp;
+        }
+    }
+};
@@ -0,0 +1,157 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// 带版本号的无锁 Treiber 栈。
+// 栈顶指针和一个版本号打包在同一个 64 位原子量里，每次 push/pop 版本号加一，
+// 这样“弹出 A → 别的线程弹出 A、B 再压回 A”这类 ABA 交错会让 CAS 失败。
+// - 64 位平台：低 48 位放指针（x86-64 / AArch64 用户态地址），高 16 位放版本号；
+// - 32 位平台：低 32 位放指针，高 32 位放版本号。
+// 节点内存在栈的生命周期内不能归还给系统：pop 可能读到已被别的线程取走的节点的 next，
+// 这个值随后会因版本号不符而被丢弃。
+// Node 需要有成员 std::atomic<Node*> next。
+//
+// 指针打包只在保证用户态地址放得进低 48 位的平台上启用（POOL_TAGGED_POINTERS=1）：
+// 32 位平台、x86-64，以及不在指针高位放标签的 AArch64。x86-64 的 5 级页表只有 mmap 显式要求时
+// 才给出 47 位以上的地址；Android 的堆指针和 HWASan / MTE 会在 AArch64 指针最高字节放标签，
+// 所以这些情况下不启用。其余平台退回到 LockedStack（自旋锁保护的普通栈），接口相同。
+// ConcurrentStack<Node> 是当前平台选用的那一个；也可以编译时定义 POOL_TAGGED_POINTERS=0 强制用锁。
+
+#ifndef POOL_TAGGED_POINTERS
+#if UINTPTR_MAX == 0xFFFFFFFFu
+#define POOL_TAGGED_POINTERS 1
+#elif defined(__x86_64__) || defined(_M_X64)
+#define POOL_TAGGED_POINTERS 1
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && !defined(__ANDROID__) && \
+    !defined(__SANITIZE_HWADDRESS__) && !defined(__ARM_FEATURE_MEMORY_TAGGING)
+#define POOL_TAGGED_POINTERS 1
+#else
+#define POOL_TAGGED_POINTERS 0
+#endif
+#endif
+
+namespace pool_detail {
+
+template <class Node>
+class TaggedStack {
+public:
+    TaggedStack() noexcept = default;
+    TaggedStack(const TaggedStack&) = delete;
+    TaggedStack& operator=(const TaggedStack&) = delete;
+
+    void push(Node* n) noexcept {
+        std::uint64_t old = head_.load(std::memory_order_relaxed);
+        std::uint64_t desired;
+        do {
+            n->next.store(unpack(old), std::memory_order_relaxed);
+            desired = pack(n, tag_of(old) + 1);
+        } while (!head_.compare_exchange_weak(old, desired,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    Node* pop() noexcept {
+        std::uint64_t old = head_.load(std::memory_order_acquire);
+        while (Node* n = unpack(old)) {
+            Node* next = n->next.load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(old, pack(next, tag_of(old) + 1),
+                                            std::memory_order_acquire,
+                                            std::memory_order_acquire))
+                return n;
+        }
+        return nullptr;
+    }
+
+    bool empty() const noexcept {
+        return unpack(head_.load(std::memory_order_relaxed)) == nullptr;
+    }
+
+    bool is_lock_free() const noexcept { return head_.is_lock_free(); }
+
+private:
+    static_assert(sizeof(void*) == 4 || sizeof(void*) == 8, "TaggedStack packs 32- or 64-bit pointers");
+
+    static constexpr unsigned pointer_bits = sizeof(void*) == 8 ? 48 : 32;
+    static constexpr std::uint64_t pointer_mask = (std::uint64_t(1) << pointer_bits) - 1;
+
+    std::atomic<std::uint64_t> head_{0};
+
+    static std::uint64_t pack(Node* n, std::uint64_t tag) noexcept {
+        std::uint64_t bits = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(n));
+        // 平台判断出错时（例如显式申请了高位地址）与其悄悄截断指针，不如立刻停下
+        if ((bits & ~pointer_mask) != 0) pointer_out_of_range(n);
+        return bits | (tag << pointer_bits);
+    }
+
+    [[noreturn]] static void pointer_out_of_range(const void* n) noexcept {
+        std::fprintf(stderr, "TaggedStack: node %p does not fit in %u bits; build with POOL_TAGGED_POINTERS=0\n",
+                     n, pointer_bits);
+        std::abort();
+    }
+
+    static Node* unpack(std::uint64_t v) noexcept {
+        return reinterpret_cast<Node*>(static_cast<std::uintptr_t>(v & pointer_mask));
+    }
+
+    static std::uint64_t tag_of(std::uint64_t v) noexcept {
+        return v >> pointer_bits;
+    }
+};
+
+// 指针打包没有保证时的替代：一把自旋锁保护的单链表栈。
+// 临界区只有几条指令，不会阻塞在系统调用上；节点同样要在栈的生命周期内保持有效
+template <class Node>
+class LockedStack {
+public:
+    LockedStack() noexcept = default;
+    LockedStack(const LockedStack&) = delete;
+    LockedStack& operator=(const LockedStack&) = delete;
+
+    void push(Node* n) noexcept {
+        lock();
+        n->next.store(head_, std::memory_order_relaxed);
+        head_ = n;
+        unlock();
+    }
+
+    Node* pop() noexcept {
+        lock();
+        Node* n = head_;
+        if (n) head_ = n->next.load(std::memory_order_relaxed);
+        unlock();
+        return n;
+    }
+
+    bool empty() const noexcept {
+        const_cast<LockedStack*>(this)->lock();
+        bool e = head_ == nullptr;
+        const_cast<LockedStack*>(this)->unlock();
+        return e;
+    }
+
+    bool is_lock_free() const noexcept { return false; }
+
+private:
+    std::atomic_flag locked_ = ATOMIC_FLAG_INIT;
+    Node* head_ = nullptr;
+
+    void lock() noexcept {
+        while (locked_.test_and_set(std::memory_order_acquire)) {
+        }
+    }
+
+    void unlock() noexcept { locked_.clear(std::memory_order_release); }
+};
+
+#if POOL_TAGGED_POINTERS
+template <class Node>
+using ConcurrentStack = TaggedStack<Node>;
+#else
+template <class Node>
+using ConcurrentStack = LockedStack<Node>;
+#endif
+
+} // namespace pool_detail
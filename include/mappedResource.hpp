@@ -0,0 +1,432 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <algorithm>
+#include "poolAllocator.hpp"
+#include "simpleSeq.hpp"
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "mappedResource.hpp needs POSIX mmap"
+#endif
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 以 mmap 文件为后备存储的内存资源，用来把几十 GB 的 SimpleSeq<POD> 数据存进文件、下次启动直接挂上：
+// - 打开时先保留一大段虚拟地址（reserve_bytes，不占内存），文件映射在开头，
+//   文件变大时在后面接着 MAP_FIXED 映射，本次运行内基址不变，裸指针一直有效；
+// - 文件里只记偏移：各级空闲链表、命名根（root）、MappedSeq 的数据位置都是相对文件开头的偏移，
+//   换一个进程、映射到别的地址照样能用；OffsetPtr<T> 是存在文件里的自相对指针，用于用户自己的结构；
+// - 按 2 的幂分级分配，释放的块挂回本级的空闲链表（链表也在文件里），重启后继续复用；
+// - 重新打开时不读数据，只有真正访问到的页才会从文件缺页载入。
+// MappedResource 是 std::pmr::memory_resource，pmr 容器可以直接用它做（本次运行内的）大内存后备；
+// 要跨进程保存的数组用 MappedSeq<T>。不加锁；崩溃一致性不做保证，需要落盘时调用 flush()。
+
+namespace pool_detail {
+
+struct MappedRoot {
+    char name[24];
+    std::uint64_t offset;
+};
+
+struct MappedHeader {
+    static constexpr std::uint64_t current_version = 1;
+    static constexpr std::size_t max_class = 48;
+    static constexpr std::size_t max_roots = 32;
+
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t file_bytes;
+    // 已经切出去的字节数（下一个新块的起始偏移）
+    std::uint64_t used;
+    // free_heads[k]：大小为 2^k 的空闲块链表头的偏移，0 表示空
+    std::uint64_t free_heads[max_class + 1];
+    MappedRoot roots[max_roots];
+};
+
+inline constexpr char mapped_magic[8] = {'P', 'O', 'O', 'L', 'M', 'A', 'P', '1'};
+
+[[noreturn]] inline void throw_errno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+} // namespace pool_detail
+
+class MappedResource : public std::pmr::memory_resource {
+public:
+    using size_type = std::size_t;
+    using offset_type = std::uint64_t;
+
+    // 每块开头的头部占用的字节数，也是 payload 的最大对齐
+    static constexpr size_type block_header = 64;
+    static constexpr size_type min_class = 7;
+    static constexpr size_type default_reserve_bytes = size_type(1) << 40;
+
+    // 打开（不存在就创建）path；reserve_bytes 是本次运行中文件能长到的上限
+    explicit MappedResource(const char* path, size_type reserve_bytes = default_reserve_bytes) {
+        fd_ = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) pool_detail::throw_errno("MappedResource: open");
+        try {
+            attach(reserve_bytes);
+        } catch (...) {
+            close_all();
+            throw;
+        }
+    }
+
+    explicit MappedResource(const std::string& path, size_type reserve_bytes = default_reserve_bytes)
+        : MappedResource(path.c_str(), reserve_bytes) {}
+
+    MappedResource(const MappedResource&) = delete;
+    MappedResource& operator=(const MappedResource&) = delete;
+
+    ~MappedResource() override { close_all(); }
+
+    char* base() const noexcept { return base_; }
+    size_type file_bytes() const noexcept { return header()->file_bytes; }
+    size_type used_bytes() const noexcept { return header()->used; }
+
+    offset_type offset_of(const void* p) const noexcept {
+        return p ? static_cast<offset_type>(static_cast<const char*>(p) - base_) : 0;
+    }
+
+    void* pointer_at(offset_type off) const noexcept { return off ? base_ + off : nullptr; }
+
+    // 命名根：把一个偏移以 name 记在文件头里，下次打开按名字找回来（0 表示没有）
+    offset_type root(const char* name) const noexcept {
+        const pool_detail::MappedRoot* r = find_root(name);
+        return r ? r->offset : 0;
+    }
+
+    void set_root(const char* name, offset_type off) {
+        if (std::strlen(name) >= sizeof(pool_detail::MappedRoot::name))
+            throw std::length_error("MappedResource: root name too long");
+        pool_detail::MappedRoot* r = find_root(name);
+        if (!r) {
+            for (auto& slot : header()->roots) {
+                if (slot.name[0] == '\0') {
+                    r = &slot;
+                    std::strncpy(r->name, name, sizeof(r->name) - 1);
+                    break;
+                }
+            }
+        }
+        if (!r) throw std::length_error("MappedResource: too many roots");
+        r->offset = off;
+    }
+
+    // 把脏页同步写回文件
+    void flush() {
+        if (::msync(base_, file_bytes(), MS_SYNC) != 0) pool_detail::throw_errno("MappedResource: msync");
+    }
+
+    // bytes 字节的请求实际拿到的可用字节数
+    static constexpr size_type usable_bytes(size_type bytes) noexcept {
+        return (size_type(1) << class_of(bytes)) - block_header;
+    }
+
+protected:
+    void* do_allocate(size_type bytes, size_type align) override {
+        if (align > block_header) throw std::bad_alloc();
+        if (bytes > (size_type(1) << pool_detail::MappedHeader::max_class) - block_header) throw std::bad_alloc();
+        size_type cls = class_of(bytes);
+        pool_detail::MappedHeader* h = header();
+        offset_type off = h->free_heads[cls];
+        if (off) {
+            h->free_heads[cls] = block_at(off)->next_free;
+        } else {
+            size_type size = size_type(1) << cls;
+            ensure_file(h->used + size);
+            h = header();
+            off = h->used;
+            h->used += size;
+        }
+        Block* b = block_at(off);
+        b->size_class = cls;
+        b->next_free = 0;
+        return base_ + off + block_header;
+    }
+
+    void do_deallocate(void* p, size_type, size_type) override {
+        offset_type off = offset_of(p) - block_header;
+        Block* b = block_at(off);
+        pool_detail::MappedHeader* h = header();
+        b->next_free = h->free_heads[b->size_class];
+        h->free_heads[b->size_class] = off;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    struct Block {
+        std::uint64_t size_class;
+        std::uint64_t next_free;
+    };
+
+    int fd_ = -1;
+    char* base_ = nullptr;
+    size_type reserved_ = 0;
+
+    pool_detail::MappedHeader* header() const noexcept {
+        return reinterpret_cast<pool_detail::MappedHeader*>(base_);
+    }
+
+    Block* block_at(offset_type off) const noexcept { return reinterpret_cast<Block*>(base_ + off); }
+
+    static constexpr size_type class_of(size_type bytes) noexcept {
+        size_type cls = min_class;
+        while ((size_type(1) << cls) < bytes + block_header) ++cls;
+        return cls;
+    }
+
+    static size_type page_size() noexcept {
+        static const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+        return page;
+    }
+
+    static size_type data_start() noexcept {
+        return pool_detail::align_up(sizeof(pool_detail::MappedHeader), block_header);
+    }
+
+    void attach(size_type reserve_bytes) {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) pool_detail::throw_errno("MappedResource: fstat");
+        size_type existing = static_cast<size_type>(st.st_size);
+        bool fresh = existing == 0;
+        if (fresh) {
+            existing = pool_detail::align_up(data_start(), page_size());
+            if (::ftruncate(fd_, static_cast<off_t>(existing)) != 0) pool_detail::throw_errno("MappedResource: ftruncate");
+        } else if (existing < sizeof(pool_detail::MappedHeader)) {
+            throw std::runtime_error("MappedResource: file too small to be a pool file");
+        }
+        reserved_ = pool_detail::align_up(std::max(reserve_bytes, existing), page_size());
+
+        // 先保留整段地址，再把文件映射到开头
+        void* r = ::mmap(nullptr, reserved_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (r == MAP_FAILED) pool_detail::throw_errno("MappedResource: reserve address space");
+        base_ = static_cast<char*>(r);
+        map_range(0, existing);
+
+        pool_detail::MappedHeader* h = header();
+        if (fresh) {
+            std::memcpy(h->magic, pool_detail::mapped_magic, sizeof(h->magic));
+            h->version = pool_detail::MappedHeader::current_version;
+            h->file_bytes = existing;
+            h->used = data_start();
+        } else if (std::memcmp(h->magic, pool_detail::mapped_magic, sizeof(h->magic)) != 0 ||
+                   h->version != pool_detail::MappedHeader::current_version || h->file_bytes != existing) {
+            throw std::runtime_error("MappedResource: not a pool file or incompatible version");
+        }
+    }
+
+    void map_range(size_type from, size_type to) {
+        void* p = ::mmap(base_ + from, to - from, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd_,
+                         static_cast<off_t>(from));
+        if (p == MAP_FAILED) pool_detail::throw_errno("MappedResource: mmap");
+    }
+
+    // 文件至少要有 need 字节；按翻倍增长，新增部分接在原映射后面
+    void ensure_file(size_type need) {
+        size_type have = header()->file_bytes;
+        if (need <= have) return;
+        size_type grown = pool_detail::align_up(std::max(need, have * 2), page_size());
+        if (grown > reserved_) grown = pool_detail::align_up(need, page_size());
+        if (grown > reserved_) throw std::bad_alloc();
+        if (::ftruncate(fd_, static_cast<off_t>(grown)) != 0) pool_detail::throw_errno("MappedResource: ftruncate");
+        map_range(have, grown);
+        header()->file_bytes = grown;
+    }
+
+    pool_detail::MappedRoot* find_root(const char* name) const noexcept {
+        for (auto& r : header()->roots)
+            if (r.name[0] != '\0' && std::strncmp(r.name, name, sizeof(r.name)) == 0) return &r;
+        return nullptr;
+    }
+
+    void close_all() noexcept {
+        if (base_) ::munmap(base_, reserved_);
+        if (fd_ >= 0) ::close(fd_);
+        base_ = nullptr;
+        fd_ = -1;
+    }
+};
+
+// 自相对指针：存的是目标地址减去自身地址，整段内存映射到哪里都指向同一个对象。
+// 只在指针本身和目标都位于同一段映射里时有意义；0 表示空指针。
+template <class T>
+class OffsetPtr {
+public:
+    OffsetPtr() noexcept = default;
+    OffsetPtr(T* p) noexcept { set(p); }
+    OffsetPtr(const OffsetPtr& other) noexcept { set(other.get()); }
+    OffsetPtr& operator=(const OffsetPtr& other) noexcept {
+        set(other.get());
+        return *this;
+    }
+    OffsetPtr& operator=(T* p) noexcept {
+        set(p);
+        return *this;
+    }
+
+    T* get() const noexcept {
+        return diff_ ? reinterpret_cast<T*>(reinterpret_cast<std::intptr_t>(this) + diff_) : nullptr;
+    }
+    T& operator*() const noexcept { return *get(); }
+    T* operator->() const noexcept { return get(); }
+    explicit operator bool() const noexcept { return diff_ != 0; }
+
+private:
+    std::intptr_t diff_ = 0;
+
+    void set(T* p) noexcept {
+        diff_ = p ? reinterpret_cast<std::intptr_t>(p) - reinterpret_cast<std::intptr_t>(this) : 0;
+    }
+};
+
+// 存在 MappedResource 文件里的可平凡拷贝元素数组，接口与 SimpleSeq 相同的那部分保持一致。
+// 元数据（数据偏移、大小、容量）也放在文件里，以 name 作为根保存；
+// 再次打开同一个文件、用同一个名字构造就挂回原来的数据，不拷贝、不重建。
+template <typename T, typename Growth = DoublingGrowth<>>
+class MappedSeq {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedSeq stores raw bytes; T must be trivially copyable");
+    static_assert(alignof(T) <= MappedResource::block_header, "MappedSeq elements are at most 64-byte aligned");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    MappedSeq(MappedResource& resource, const char* name) : res_(&resource) {
+        MappedResource::offset_type off = resource.root(name);
+        if (off) {
+            rec_ = static_cast<Record*>(resource.pointer_at(off));
+            if (rec_->elem_size != sizeof(T))
+                throw std::runtime_error("MappedSeq: stored element size does not match T");
+        } else {
+            rec_ = static_cast<Record*>(resource.allocate(sizeof(Record), alignof(Record)));
+            *rec_ = Record{0, 0, 0, sizeof(T)};
+            try {
+                resource.set_root(name, resource.offset_of(rec_));
+            } catch (...) {
+                resource.deallocate(rec_, sizeof(Record), alignof(Record));
+                throw;
+            }
+        }
+    }
+
+    MappedSeq(const MappedSeq&) = delete;
+    MappedSeq& operator=(const MappedSeq&) = delete;
+
+    size_type size() const noexcept { return rec_->size; }
+    size_type capacity() const noexcept { return rec_->capacity; }
+    bool empty() const noexcept { return rec_->size == 0; }
+
+    T* data() noexcept { return static_cast<T*>(res_->pointer_at(rec_->data)); }
+    const T* data() const noexcept { return static_cast<const T*>(res_->pointer_at(rec_->data)); }
+    T& operator[](size_type i) noexcept { return data()[i]; }
+    const T& operator[](size_type i) const noexcept { return data()[i]; }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + size(); }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + size(); }
+
+    void push_back(const T& v) {
+        if (rec_->size == rec_->capacity) {
+            // v 可能引用本数组里的元素，换缓冲区之前先拷出来
+            T copy = v;
+            grow_to(Growth::next_capacity(rec_->capacity, rec_->size + 1, sizeof(T)));
+            data()[rec_->size++] = copy;
+            return;
+        }
+        data()[rec_->size++] = v;
+    }
+
+    void pop_back() noexcept { --rec_->size; }
+
+    // 用 [first, last) 替换全部内容；指针区间直接 memcpy
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    void assign(It first, It last) {
+        clear();
+        append(first, last);
+    }
+
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    void append(It first, It last) {
+        if constexpr (seq_detail::is_forward_iterator<It>) {
+            size_type n = static_cast<size_type>(std::distance(first, last));
+            reserve_for(rec_->size + n);
+            if constexpr (seq_detail::is_memcpy_source<It, T>) {
+                if (n) std::memcpy(static_cast<void*>(data() + rec_->size), static_cast<const void*>(first), n * sizeof(T));
+            } else {
+                std::copy(first, last, data() + rec_->size);
+            }
+            rec_->size += n;
+        } else {
+            for (; first != last; ++first) push_back(*first);
+        }
+    }
+
+    // 新元素值初始化（清零）
+    void resize(size_type n) {
+        if (n > rec_->size) {
+            reserve_for(n);
+            std::memset(static_cast<void*>(data() + rec_->size), 0, (n - rec_->size) * sizeof(T));
+        }
+        rec_->size = n;
+    }
+
+    void resize(size_type n, const T& v) {
+        if (n > rec_->size) {
+            T copy = v;
+            reserve_for(n);
+            std::fill(data() + rec_->size, data() + n, copy);
+        }
+        rec_->size = n;
+    }
+
+    void reserve(size_type new_cap) {
+        if (new_cap > rec_->capacity) grow_to(new_cap);
+    }
+
+    void clear() noexcept { rec_->size = 0; }
+
+private:
+    struct Record {
+        std::uint64_t data;
+        std::uint64_t size;
+        std::uint64_t capacity;
+        std::uint64_t elem_size;
+    };
+
+    MappedResource* res_;
+    Record* rec_;
+
+    void reserve_for(size_type required) {
+        if (required > rec_->capacity)
+            grow_to(std::max(Growth::next_capacity(rec_->capacity, required, sizeof(T)), required));
+    }
+
+    // 新容量按分级向上取整，级别里多出来的空间直接算作容量
+    void grow_to(size_type new_cap) {
+        if (new_cap > (~size_type(0) - MappedResource::block_header) / sizeof(T))
+            throw std::length_error("MappedSeq: capacity too large");
+        T* fresh = static_cast<T*>(res_->allocate(new_cap * sizeof(T), alignof(T)));
+        size_type usable = MappedResource::usable_bytes(new_cap * sizeof(T)) / sizeof(T);
+        if (rec_->size) std::memcpy(static_cast<void*>(fresh), static_cast<const void*>(data()), rec_->size * sizeof(T));
+        if (rec_->data) res_->deallocate(data(), rec_->capacity * sizeof(T), alignof(T));
+        rec_->data = res_->offset_of(fresh);
+        rec_->capacity = usable;
+    }
+};
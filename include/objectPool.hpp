@@ -0,0 +1,204 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include "poolAllocator.hpp"
+#include "concurrentPoolAllocator.hpp"
+
+// 已构造对象的缓存池：PoolAllocator 只回收内存，构造昂贵的对象（自带缓冲区的消息等）
+// 每次仍要重新构造、析构；ObjectPool 把用完的对象原样留着，下次 acquire() 直接交出去。
+// - acquire() 返回 ObjectPool<T>::Handle（带自定义删除器的 unique_ptr），析构时对象回到池里而不是被销毁；
+// - 可选的 reset 钩子在对象回池时调用（比如 clear() 掉内容但保留容量）；钩子抛异常时该对象直接销毁；
+// - 空闲对象串成侵入式链表，链接指针和对象放在同一个槽位里，槽位从 Alloc（默认 PoolAllocator）取；
+// - 每个线程有自己的空闲链表（按 ThreadSlots 编号），命中时不加锁；
+//   超过 thread_cache_limit 个时把一半还给共享链表，本线程缓存空了从共享链表取。
+// 池必须比它交出去的所有 Handle 活得久；池析构时销毁所有空闲对象。
+
+template <typename T, typename Alloc = PoolAllocator<T>>
+class ObjectPool {
+    struct Node {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Node* next;
+
+        T* object() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    using node_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_alloc>;
+
+public:
+    using size_type = std::size_t;
+    using reset_hook = std::function<void(T&)>;
+
+    static constexpr size_type default_thread_cache_limit = 64;
+
+    class Releaser {
+    public:
+        Releaser() noexcept = default;
+        explicit Releaser(ObjectPool* pool) noexcept : pool_(pool) {}
+        void operator()(T* p) const noexcept { pool_->recycle(p); }
+
+    private:
+        ObjectPool* pool_ = nullptr;
+    };
+
+    using Handle = std::unique_ptr<T, Releaser>;
+
+    explicit ObjectPool(reset_hook reset = nullptr, size_type thread_cache_limit = default_thread_cache_limit,
+                        const Alloc& alloc = Alloc())
+        : reset_(std::move(reset)), limit_(std::max<size_type>(thread_cache_limit, 2)), alloc_(alloc),
+          caches_(new ThreadCache[pool_detail::ThreadSlots::max_slots]) {}
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ~ObjectPool() {
+        for (size_type t = 0; t < pool_detail::ThreadSlots::max_slots; ++t) destroy_list(caches_[t].head);
+        destroy_list(shared_);
+    }
+
+    // 有空闲对象就直接交出去，否则默认构造一个新的
+    Handle acquire() {
+        size_type t = pool_detail::ThreadSlots::current();
+        if (t != pool_detail::ThreadSlots::none) {
+            ThreadCache& c = caches_[t];
+            if (!c.head) refill(c);
+            if (Node* n = c.head) {
+                c.head = n->next;
+                --c.count;
+                return Handle(n->object(), Releaser(this));
+            }
+        } else if (Node* n = pop_shared()) {
+            return Handle(n->object(), Releaser(this));
+        }
+        return Handle(create(), Releaser(this));
+    }
+
+    // 预先构造 n 个对象放进共享链表
+    void reserve(size_type n) {
+        for (size_type i = 0; i < n; ++i) {
+            Node* node = node_of(create());
+            std::lock_guard<std::mutex> lock(mutex_);
+            node->next = shared_;
+            shared_ = node;
+        }
+    }
+
+    // 一共构造过多少个对象（包括已经因 reset 钩子失败被销毁的）
+    size_type constructed() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return constructed_;
+    }
+
+private:
+    struct alignas(pool_detail::cache_line_size) ThreadCache {
+        Node* head = nullptr;
+        size_type count = 0;
+    };
+
+    reset_hook reset_;
+    size_type limit_;
+    // mutex_ 保护 alloc_、共享链表和计数；各线程的 ThreadCache 只由所属线程访问
+    mutable std::mutex mutex_;
+    node_alloc alloc_;
+    std::unique_ptr<ThreadCache[]> caches_;
+    Node* shared_ = nullptr;
+    size_type constructed_ = 0;
+
+    static Node* node_of(T* p) noexcept { return reinterpret_cast<Node*>(p); }
+
+    // 只在锁里分配槽位，构造放在锁外
+    T* create() {
+        Node* n;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            n = node_traits::allocate(alloc_, 1);
+        }
+        try {
+            ::new (static_cast<void*>(n->storage)) T();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            node_traits::deallocate(alloc_, n, 1);
+            throw;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++constructed_;
+        return n->object();
+    }
+
+    void destroy(Node* n) noexcept {
+        n->object()->~T();
+        std::lock_guard<std::mutex> lock(mutex_);
+        node_traits::deallocate(alloc_, n, 1);
+    }
+
+    void destroy_list(Node* n) noexcept {
+        while (n) {
+            Node* next = n->next;
+            destroy(n);
+            n = next;
+        }
+    }
+
+    Node* pop_shared() noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Node* n = shared_;
+        if (n) {
+            shared_ = n->next;
+        }
+        return n;
+    }
+
+    // 从共享链表一次取最多 limit_ / 2 个
+    void refill(ThreadCache& c) noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_type i = 0; i < limit_ / 2 && shared_; ++i) {
+            Node* n = shared_;
+            shared_ = n->next;
+            n->next = c.head;
+            c.head = n;
+            ++c.count;
+        }
+    }
+
+    void recycle(T* p) noexcept {
+        Node* n = node_of(p);
+        if (reset_) {
+            try {
+                reset_(*p);
+            } catch (...) {
+                destroy(n);
+                return;
+            }
+        }
+        size_type t = pool_detail::ThreadSlots::current();
+        if (t == pool_detail::ThreadSlots::none) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            n->next = shared_;
+            shared_ = n;
+            return;
+        }
+        ThreadCache& c = caches_[t];
+        n->next = c.head;
+        c.head = n;
+        if (++c.count > limit_) spill(c);
+    }
+
+    // 把本线程缓存的一半挪到共享链表，给别的线程用
+    void spill(ThreadCache& c) noexcept {
+        size_type keep = c.count / 2;
+        Node* last = c.head;
+        for (size_type i = 1; i < keep; ++i) last = last->next;
+        Node* first = last->next;
+        last->next = nullptr;
+        Node* tail = first;
+        while (tail->next) tail = tail->next;
+        c.count = keep;
+        std::lock_guard<std::mutex> lock(mutex_);
+        tail->next = shared_;
+        shared_ = first;
+    }
+};
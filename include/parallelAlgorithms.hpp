@@ -0,0 +1,173 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include "simpleSeq.hpp"
+#include "taskPool.hpp"
+
+// 基于 TaskPool 的并行算法，面向 SimpleSeq 这类连续存储（也接受任意随机访问迭代器）：
+// - parallel_for_each / parallel_transform：区间切成若干块，每块一个任务；
+// - parallel_reduce：每块先局部归约，再按块的顺序合并，op 需满足结合律；
+// - parallel_sort：各块并行 std::sort，再逐轮两两归并，归并本身也按分割点拆成多个任务；
+//   临时缓冲区来自调用线程的 scratch_allocator()，排序结果与 std::sort 一样不保证稳定。
+// grain 是每个任务至少处理的元素个数，传 0 时按线程数自动选取；parallel_sort 的 grain 至少为 4096，
+// 传入更小的值也按 4096 处理。
+// 各接口都有直接传容器（begin()/end()）的重载。
+
+namespace par_detail {
+
+inline size_type pick_grain(size_type n, size_type grain, const TaskPool& pool, size_type min_grain) noexcept {
+    if (grain) return std::max(grain, min_grain);
+    size_type g = n / ((pool.worker_count() + 1) * 4);
+    return std::max(g, min_grain);
+}
+
+// 把 [0, n) 按 grain 切块，body(begin, end) 在池里执行，最后一块在当前线程执行
+template <class Body>
+void for_chunks(TaskPool& pool, size_type n, size_type grain, Body&& body) {
+    if (n == 0) return;
+    if (n <= grain) {
+        body(size_type(0), n);
+        return;
+    }
+    TaskGroup group(pool);
+    size_type start = 0;
+    for (; start + grain < n; start += grain) {
+        size_type end = start + grain;
+        group.run([&body, start, end] { body(start, end); });
+    }
+    body(start, n);
+    group.wait();
+}
+
+// 把有序的 [a0, a1) 和 [b0, b1) 移动归并到 out：按较长一段的中点切开，两半各自独立，
+// 直到每块不超过 grain 才交给任务执行。
+// grain 至少取 2：超过 grain 时较长一段至少有 2 个元素，中点两侧都非空，两半都严格变小
+template <class It, class Out, class Compare>
+void merge_split(TaskGroup& group, It a0, It a1, It b0, It b1, Out out, Compare& comp, size_type grain) {
+    grain = std::max<size_type>(grain, 2);
+    for (;;) {
+        size_type na = static_cast<size_type>(a1 - a0), nb = static_cast<size_type>(b1 - b0);
+        if (na + nb <= grain) {
+            group.run([=, &comp] {
+                std::merge(std::make_move_iterator(a0), std::make_move_iterator(a1), std::make_move_iterator(b0),
+                           std::make_move_iterator(b1), out, std::ref(comp));
+            });
+            return;
+        }
+        It am, bm;
+        if (na >= nb) {
+            am = a0 + std::max<size_type>(na / 2, 1);
+            bm = std::lower_bound(b0, b1, *am, std::ref(comp));
+        } else {
+            bm = b0 + std::max<size_type>(nb / 2, 1);
+            am = std::upper_bound(a0, a1, *bm, std::ref(comp));
+        }
+        merge_split(group, a0, am, b0, bm, out, comp, grain);
+        out += (am - a0) + (bm - b0);
+        a0 = am;
+        b0 = bm;
+    }
+}
+
+} // namespace par_detail
+
+template <class It, class F>
+void parallel_for_each(TaskPool& pool, It first, It last, F f, std::size_t grain = 0) {
+    std::size_t n = static_cast<std::size_t>(last - first);
+    grain = par_detail::pick_grain(n, grain, pool, 1);
+    par_detail::for_chunks(pool, n, grain, [&](std::size_t b, std::size_t e) {
+        for (It it = first + b, stop = first + e; it != stop; ++it) f(*it);
+    });
+}
+
+template <class Range, class F>
+void parallel_for_each(TaskPool& pool, Range& r, F f) {
+    parallel_for_each(pool, r.begin(), r.end(), std::move(f));
+}
+
+// out 指向至少 last - first 个已存在的元素，可以与 first 相同（原地变换）
+template <class It, class Out, class F>
+Out parallel_transform(TaskPool& pool, It first, It last, Out out, F f, std::size_t grain = 0) {
+    std::size_t n = static_cast<std::size_t>(last - first);
+    grain = par_detail::pick_grain(n, grain, pool, 1);
+    par_detail::for_chunks(pool, n, grain, [&](std::size_t b, std::size_t e) {
+        std::transform(first + b, first + e, out + b, f);
+    });
+    return out + n;
+}
+
+template <class Range, class Out, class F>
+Out parallel_transform(TaskPool& pool, const Range& r, Out out, F f) {
+    return parallel_transform(pool, r.begin(), r.end(), out, std::move(f));
+}
+
+template <class It, class T, class Op = std::plus<>>
+T parallel_reduce(TaskPool& pool, It first, It last, T init, Op op = Op(), std::size_t grain = 0) {
+    std::size_t n = static_cast<std::size_t>(last - first);
+    if (n == 0) return init;
+    grain = par_detail::pick_grain(n, grain, pool, 1);
+    std::size_t chunks = (n + grain - 1) / grain;
+    // 每块的部分和放在各自的槽位里，最后按顺序合并，结果与块的执行顺序无关
+    SimpleSeq<T, PoolAllocator<T>> partial(0, scratch_allocator<T>());
+    partial.reserve(chunks);
+    for (std::size_t c = 0; c < chunks; ++c) partial.push_back(init);
+    par_detail::for_chunks(pool, n, grain, [&](std::size_t b, std::size_t e) {
+        T acc = *(first + b);
+        for (It it = first + b + 1, stop = first + e; it != stop; ++it) acc = op(std::move(acc), *it);
+        partial[b / grain] = std::move(acc);
+    });
+    T result = std::move(init);
+    for (auto& p : partial) result = op(std::move(result), std::move(p));
+    return result;
+}
+
+template <class Range, class T, class Op = std::plus<>>
+T parallel_reduce(TaskPool& pool, const Range& r, T init, Op op = Op()) {
+    return parallel_reduce(pool, r.begin(), r.end(), std::move(init), std::move(op));
+}
+
+template <class It, class Compare = std::less<>>
+void parallel_sort(TaskPool& pool, It first, It last, Compare comp = Compare(), std::size_t grain = 0) {
+    using T = typename std::iterator_traits<It>::value_type;
+    std::size_t n = static_cast<std::size_t>(last - first);
+    grain = par_detail::pick_grain(n, grain, pool, 4096);
+    if (n <= grain) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    // 元素先整体移到 scratch 里分块排序，再在 scratch 和 [first, last) 之间来回归并，每轮有序段的长度翻倍；
+    // 原区间里留下的是被移走的对象，只作为归并的赋值目标
+    SimpleSeq<T, PoolAllocator<T>> scratch(0, scratch_allocator<T>());
+    scratch.assign(std::make_move_iterator(first), std::make_move_iterator(last));
+    T* buf = scratch.data();
+    par_detail::for_chunks(pool, n, grain, [&](std::size_t b, std::size_t e) {
+        std::sort(buf + b, buf + e, comp);
+    });
+    bool in_scratch = true;
+    for (std::size_t width = grain; width < n; width *= 2) {
+        TaskGroup group(pool);
+        for (std::size_t b = 0; b < n; b += 2 * width) {
+            std::size_t m = std::min(b + width, n), e = std::min(b + 2 * width, n);
+            if (in_scratch)
+                par_detail::merge_split(group, buf + b, buf + m, buf + m, buf + e, first + b, comp, grain);
+            else
+                par_detail::merge_split(group, first + b, first + m, first + m, first + e, buf + b, comp, grain);
+        }
+        group.wait();
+        in_scratch = !in_scratch;
+    }
+    if (in_scratch) {
+        par_detail::for_chunks(pool, n, grain, [&](std::size_t b, std::size_t e) {
+            std::move(buf + b, buf + e, first + b);
+        });
+    }
+}
+
+template <class Range, class Compare = std::less<>>
+void parallel_sort(TaskPool& pool, Range& r, Compare comp = Compare()) {
+    parallel_sort(pool, r.begin(), r.end(), std::move(comp));
+}
@@ -7,6 +7,1030 @@
 #include <type_traits>
 #include <new>
 #include <algorithm>
+#include <iterator>
+#include <limits>
+#include <cstdint>
+#include <ostream>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <sched.h>
+#endif
+
+// 统计开关（编译期）：
+// - POOL_ALLOCATOR_STATS=1：记录峰值、空闲链表命中次数、大块分配次数等热路径计数；
+// - POOL_ALLOCATOR_HISTOGRAM=1：另外记录按 2 的幂分级的请求大小直方图；
+// - POOL_ALLOCATOR_TRACE=1：把每次分配、释放和原地扩容记进 allocTrace.hpp 的环形缓冲区，供离线重放；
+// - POOL_ALLOCATOR_CHECKED=1：金丝雀、释放填充、重复释放和外来指针检查，见 poolDebug.hpp。
+// 关闭时热路径上没有任何额外代码；槽位总数、在用槽位、块数和扩容次数始终可用。
+#ifndef POOL_ALLOCATOR_STATS
+#define POOL_ALLOCATOR_STATS 0
+#endif
+#ifndef POOL_ALLOCATOR_HISTOGRAM
+#define POOL_ALLOCATOR_HISTOGRAM 0
+#endif
+#ifndef POOL_ALLOCATOR_TRACE
+#define POOL_ALLOCATOR_TRACE 0
+#endif
+#if POOL_ALLOCATOR_TRACE
+#include "allocTrace.hpp"
+#endif
+#include "poolDebug.hpp"
+
+// 内存块的增长方式：
+// - fixed：每块固定 initial_block_slots 个槽位；
+// - geometric：每次新块翻倍，块数随总量对数增长；
+// - capped：翻倍到 max_block_slots 后不再增长。
+enum class BlockGrowth { fixed, geometric, capped };
+
+struct PoolOptions {
+    BlockGrowth growth = BlockGrowth::geometric;
+    std::size_t initial_block_slots = 16;
+    std::size_t max_block_slots = std::size_t(1) << 16;
+    // 块按 2 MiB 对齐并取整，Linux 上用 madvise 请求透明大页，减少大树的 TLB 缺失
+    bool huge_pages = false;
+    // NUMA 本地模式（Linux）：新块用 mbind 绑定到扩容线程所在的节点，
+    // allocate 只从当前线程所在节点的块里取，deallocate 按地址还回槽位所属的块（也就是它的节点）。
+    // 每次 allocate 多一次 getcpu（vDSO）和按块地址的二分查找，只在多路服务器上值得打开。
+    bool numa_local = false;
+};
+
+struct PoolBucketStats {
+    std::size_t stride = 0;
+    std::size_t align = 0;
+    std::size_t total_slots = 0;
+    std::size_t live_slots = 0;
+    std::size_t peak_slots = 0;
+    std::size_t block_count = 0;
+    // 完全空闲、trim() 可以归还的块
+    std::size_t empty_blocks = 0;
+    std::uint64_t free_list_hits = 0;
+    std::uint64_t expand_calls = 0;
+};
+
+struct PoolStats {
+    static constexpr std::size_t histogram_bins = 64;
+
+    std::size_t total_slots = 0;
+    std::size_t live_slots = 0;
+    std::size_t live_bytes = 0;
+    // 各桶峰值之和；各桶峰值不一定同时出现，是总峰值的上界
+    std::size_t peak_slots = 0;
+    std::size_t peak_bytes = 0;
+    std::size_t block_count = 0;
+    std::size_t empty_blocks = 0;
+    std::uint64_t free_list_hits = 0;
+    std::uint64_t expand_calls = 0;
+
+    std::uint64_t large_allocations = 0;
+    std::uint64_t large_bin_hits = 0;
+    std::size_t large_live_bytes = 0;
+    std::size_t large_peak_bytes = 0;
+
+    // size_histogram[k]：请求字节数落在 (2^(k-1), 2^k] 的分配次数
+    std::uint64_t size_histogram[histogram_bins] = {};
+
+    std::vector<PoolBucketStats> buckets;
+};
+
+inline void dump_pool_stats(const PoolStats& s, std::ostream& os) {
+    os << "pool: " << s.live_slots << "/" << s.total_slots << " slots live, "
+       << s.live_bytes << " bytes live, " << s.block_count << " blocks (" << s.empty_blocks << " empty), "
+       << s.expand_calls << " expand calls\n";
+#if POOL_ALLOCATOR_STATS
+    os << "  peak: " << s.peak_slots << " slots, " << s.peak_bytes << " bytes; free-list hits: "
+       << s.free_list_hits << "\n";
+    os << "  large: " << s.large_allocations << " allocations, " << s.large_bin_hits << " bin hits, "
+       << s.large_live_bytes << " bytes live, " << s.large_peak_bytes << " bytes peak\n";
+#endif
+    for (const auto& b : s.buckets) {
+        os << "  bucket stride=" << b.stride << " align=" << b.align << ": "
+           << b.live_slots << "/" << b.total_slots << " slots, " << b.block_count << " blocks ("
+           << b.empty_blocks << " empty)";
+#if POOL_ALLOCATOR_STATS
+        os << ", peak " << b.peak_slots << ", hits " << b.free_list_hits;
+#endif
+        os << "\n";
+    }
+#if POOL_ALLOCATOR_HISTOGRAM
+    os << "  size histogram:";
+    for (std::size_t k = 0; k < PoolStats::histogram_bins; ++k)
+        if (s.size_histogram[k]) os << " <=" << (std::uint64_t(1) << k) << ":" << s.size_histogram[k];
+    os << "\n";
+#endif
+}
+
+namespace pool_detail {
+
+using size_type = std::size_t;
+
+struct Slot { Slot* next; };
+
+constexpr size_type align_up(size_type n, size_type align) noexcept {
+    return (n + align - 1) / align * align;
+}
+
+// x 最低 / 最高置位的下标（x 不为 0），按 size_type 的实际宽度计算
+inline unsigned lowest_set_bit(size_type x) noexcept {
+#if defined(_MSC_VER)
+    unsigned long i;
+#if defined(_WIN64)
+    _BitScanForward64(&i, x);
+#else
+    _BitScanForward(&i, x);
+#endif
+    return static_cast<unsigned>(i);
+#else
+    if constexpr (sizeof(size_type) == sizeof(unsigned long long))
+        return static_cast<unsigned>(__builtin_ctzll(x));
+    else if constexpr (sizeof(size_type) == sizeof(unsigned long))
+        return static_cast<unsigned>(__builtin_ctzl(x));
+    else
+        return static_cast<unsigned>(__builtin_ctz(x));
+#endif
+}
+
+inline unsigned highest_set_bit(size_type x) noexcept {
+#if defined(_MSC_VER)
+    unsigned long i;
+#if defined(_WIN64)
+    _BitScanReverse64(&i, x);
+#else
+    _BitScanReverse(&i, x);
+#endif
+    return static_cast<unsigned>(i);
+#else
+    constexpr unsigned top = std::numeric_limits<size_type>::digits - 1;
+    if constexpr (sizeof(size_type) == sizeof(unsigned long long))
+        return top - static_cast<unsigned>(__builtin_clzll(x));
+    else if constexpr (sizeof(size_type) == sizeof(unsigned long))
+        return top - static_cast<unsigned>(__builtin_clzl(x));
+    else
+        return top - static_cast<unsigned>(__builtin_clz(x));
+#endif
+}
+
+// 槽位至少要放得下一个 Slot，并按对象的对齐要求取整，保证每个槽位都正确对齐
+constexpr size_type slot_align(size_type align) noexcept {
+    return std::max(align, alignof(Slot));
+}
+
+constexpr size_type slot_stride(size_type size, size_type align) noexcept {
+    return align_up(std::max(size, sizeof(Slot)), slot_align(align));
+}
+
+inline void* allocate_bytes(size_type bytes, size_type align) {
+    if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        return ::operator new(bytes, std::align_val_t(align));
+    return ::operator new(bytes);
+}
+
+inline void deallocate_bytes(void* p, size_type align) noexcept {
+    if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        ::operator delete(p, std::align_val_t(align));
+    else
+        ::operator delete(p);
+}
+
+constexpr size_type huge_page_size = size_type(2) << 20;
+constexpr size_type numa_page_size = 4096;
+constexpr unsigned max_numa_nodes = 64;
+
+// 当前线程所在的 NUMA 节点；拿不到时当作节点 0
+inline unsigned current_numa_node() noexcept {
+#if defined(__linux__)
+    unsigned cpu = 0, node = 0;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+    if (::getcpu(&cpu, &node) == 0 && node < max_numa_nodes) return node;
+#elif defined(SYS_getcpu)
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 && node < max_numa_nodes) return node;
+#endif
+#endif
+    return 0;
+}
+
+// 把整页对齐的 [p, p + bytes) 优先放到 node 上，已经落在别处的页迁移过来。
+// 直接调 mbind 系统调用，不依赖 libnuma；内核不支持 NUMA 时调用失败，忽略即可。
+inline void bind_to_numa_node(void* p, size_type bytes, unsigned node) noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+    constexpr int mpol_preferred = 1;
+    constexpr unsigned mpol_mf_move = 1u << 1;
+    unsigned long mask = 1ul << node;
+    ::syscall(SYS_mbind, p, bytes, mpol_preferred, &mask, sizeof(mask) * 8 + 1, mpol_mf_move);
+#else
+    (void)p;
+    (void)bytes;
+    (void)node;
+#endif
+}
+
+// 按 PoolOptions 决定每个新块的槽位数、对齐，并负责块的申请与归还
+class BlockSizer {
+public:
+    explicit BlockSizer(const PoolOptions& options) noexcept
+        : options_(options), next_(std::max<size_type>(1, options.initial_block_slots)) {}
+
+    // 申请至少 count 个槽位的块实际应有的槽位数，并推进增长策略。
+    // 按页申请时把取整到整页后放得下的槽位都算上，不满一个槽位的尾部留空
+    size_type next_block_slots(size_type count, size_type stride) noexcept {
+        size_type slots = std::max(count, next_);
+        if (size_type page = page_size())
+            slots = align_up(slots * stride, page) / stride;
+        switch (options_.growth) {
+        case BlockGrowth::fixed:
+            break;
+        case BlockGrowth::geometric:
+            next_ *= 2;
+            break;
+        case BlockGrowth::capped:
+            next_ = std::min(next_ * 2, std::max(options_.max_block_slots, next_));
+            break;
+        }
+        return slots;
+    }
+
+    // 放 slots 个槽位的块要申请的字节数：按页申请时取整到整页，madvise / mbind 覆盖整个块
+    size_type block_bytes(size_type slots, size_type stride) const noexcept {
+        size_type bytes = slots * stride;
+        if (size_type page = page_size()) bytes = align_up(bytes, page);
+        return bytes;
+    }
+
+    size_type block_align(size_type align) const noexcept {
+        return std::max(align, page_size());
+    }
+
+    bool numa_local() const noexcept { return options_.numa_local; }
+
+    void* allocate_block(size_type bytes, size_type align) const {
+        return allocate_block(bytes, align, current_numa_node());
+    }
+
+    // numa_local 时绑定到 node；bytes 来自 block_bytes()，块按页对齐、长度是整页，绑定不会波及别的内存
+    void* allocate_block(size_type bytes, size_type align, unsigned node) const {
+        void* p = allocate_bytes(bytes, block_align(align));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (options_.huge_pages) ::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+        if (options_.numa_local) bind_to_numa_node(p, bytes, node);
+        return p;
+    }
+
+    void deallocate_block(void* p, size_type align) const noexcept {
+        deallocate_bytes(p, block_align(align));
+    }
+
+    void reset() noexcept { next_ = std::max<size_type>(1, options_.initial_block_slots); }
+
+private:
+    PoolOptions options_;
+    size_type next_;
+
+    // 块按页申请时的页大小，否则为 0
+    size_type page_size() const noexcept {
+        if (options_.huge_pages) return huge_page_size;
+        if (options_.numa_local) return numa_page_size;
+        return 0;
+    }
+};
+
+// 固定步长的 slab：一组内存块，每块有自己的空闲链表。
+// - 分配只在“当前块”里进行：先用块内空闲链表，再按地址顺序切出从未用过的槽位；
+//   当前块满了，换成还有空位的块里最满的那个，都满了才申请新块。
+//   这样长期运行、反复增删之后，活着的节点仍然集中在少数几个块里，遍历时缓存行连续；
+// - 其余有空位的块按空位数分级挂在链表里（[1,2)、[2,4)、[4,8)……），换块时从空位最少的一级取，
+//   释放只在空位数跨过 2 的幂时换一级，都是 O(1)，与块数无关；同一级里不细分，取到的是“大致最满”的块；
+// - 新块不再一次性把所有槽位串进链表，没用到的页不会被提前触碰；
+// - deallocate 按地址二分找到所属块（块数随总量对数增长）；
+// - trim() 把完全空闲的块还给系统。
+// NUMA 本地模式下每个节点各有一个当前块，只从本节点的块里挑。
+// 检查模式下槽位间距是 stride + 红区，stride() 仍返回对象所用的步长。
+// credit 指向所属 PoolState 的预留额度：哪个桶先需要新块，就按额度申请并把它清零。
+class SlabPool {
+public:
+    SlabPool(size_type stride, size_type align, const PoolOptions& options = PoolOptions(),
+             size_type* credit = nullptr) noexcept
+        : stride_(stride), align_(align), sizer(options), numa_(options.numa_local), credit_(credit) {}
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    ~SlabPool() noexcept { release_all(); }
+
+    size_type stride() const noexcept { return stride_; }
+    size_type align() const noexcept { return align_; }
+
+    void* allocate() {
+        unsigned node = numa_ ? current_numa_node() : 0;
+        NodeBlocks& n = node_blocks(node);
+        Block* b = n.current;
+        if (!b || b->full()) {
+            if (b) b->bin = unlisted;
+            b = take_fullest(n);
+            if (!b) {
+                expand(take_credit(), node);
+                b = take_fullest(n);
+            }
+#if POOL_ALLOCATOR_STATS
+            else ++free_list_hits;
+#endif
+            b->bin = current_bin;
+            n.current = b;
+        }
+#if POOL_ALLOCATOR_STATS
+        else ++free_list_hits;
+#endif
+        Slot* s = b->free;
+        if (s) {
+            asan_unpoison(s, stride_);
+            b->free = s->next;
+#if POOL_ALLOCATOR_CHECKED
+            check_freed(*b, s);
+#endif
+        } else {
+            s = reinterpret_cast<Slot*>(b->base + b->carved++ * pitch());
+            asan_unpoison(s, stride_);
+        }
+#if POOL_ALLOCATOR_CHECKED
+        arm(s);
+#endif
+        ++b->used;
+        ++used_slots;
+#if POOL_ALLOCATOR_STATS
+        peak_slots = std::max(peak_slots, used_slots);
+#endif
+        return s;
+    }
+
+    void deallocate(void* p) noexcept {
+        Slot* s = static_cast<Slot*>(p);
+#if POOL_ALLOCATOR_CHECKED
+        Block* b = checked_block_of(s);
+        if (!b || !disarm(s)) return;
+#else
+        Block* b = block_of(s);
+#endif
+        s->next = b->free;
+        b->free = s;
+        asan_poison(s, stride_);
+        size_type free_before = b->slots - b->used;
+        --b->used;
+        --used_slots;
+        // 当前块不在分级链表里；满块释放后挂进链表，其他块的空位数跨过 2 的幂时换一级
+        if (b->bin == current_bin) return;
+        if (b->bin == unlisted) {
+            link(*b);
+        } else if (((free_before + 1) & free_before) == 0) {
+            unlink(*b);
+            link(*b);
+        }
+    }
+
+    // NUMA 本地模式下预留的槽位放在当前线程所在的节点上
+    void reserve(size_type new_cap) {
+        if (new_cap <= total_slots) return;
+        expand(new_cap - total_slots, numa_ ? current_numa_node() : 0);
+    }
+
+    // 归还所有完全空闲的块，返回归还的字节数
+    size_type trim() noexcept {
+        size_type released = 0;
+        size_type kept = 0;
+        for (size_type i = 0; i < index.size(); ++i) {
+            Block* b = index[i].block.get();
+            if (b->used == 0) {
+                NodeBlocks& n = nodes[b->node];
+                if (n.current == b) n.current = nullptr;
+                unlink(*b);
+                released += sizer.block_bytes(b->slots, pitch());
+                total_slots -= b->slots;
+                free_block(*b);
+            } else {
+                if (kept != i) index[kept] = std::move(index[i]);
+                ++kept;
+            }
+        }
+        index.resize(kept);
+        return released;
+    }
+
+    void release_all() noexcept {
+        for (Entry& e : index) free_block(*e.block);
+        index.clear();
+        nodes.clear();
+        total_slots = used_slots = 0;
+        sizer.reset();
+    }
+
+    PoolBucketStats stats() const noexcept {
+        PoolBucketStats b;
+        b.stride = stride_;
+        b.align = align_;
+        b.total_slots = total_slots;
+        b.live_slots = used_slots;
+        b.block_count = index.size();
+        for (const Entry& e : index) b.empty_blocks += e.block->used == 0;
+        b.expand_calls = expand_calls;
+#if POOL_ALLOCATOR_STATS
+        b.peak_slots = peak_slots;
+        b.free_list_hits = free_list_hits;
+#endif
+        return b;
+    }
+
+private:
+    static constexpr unsigned unlisted = ~0u;
+    static constexpr unsigned current_bin = ~0u - 1;
+    static constexpr unsigned partial_bins = std::numeric_limits<size_type>::digits;
+
+    struct Block {
+        char* base;
+        size_type slots;
+        // 已经切出去过的槽位数：[0, carved) 要么在用，要么在 free 里
+        size_type carved;
+        size_type used;
+        Slot* free;
+        unsigned node;
+        // 所在的分级链表；当前块是 current_bin，其余满块是 unlisted
+        unsigned bin;
+        Block* prev;
+        Block* next;
+
+        bool full() const noexcept { return used == slots; }
+    };
+
+    struct Entry {
+        char* base;
+        std::unique_ptr<Block> block;
+    };
+
+    // 每个 NUMA 节点一份：正在分配的块，以及其余有空位的块按空位数分级，
+    // partial[k] 里的块空位数在 [2^k, 2^(k+1))；nonempty 的第 k 位表示 partial[k] 非空
+    struct NodeBlocks {
+        Block* current = nullptr;
+        Block* partial[partial_bins] = {};
+        size_type nonempty = 0;
+    };
+
+    size_type stride_;
+    size_type align_;
+    BlockSizer sizer;
+    bool numa_;
+    size_type* credit_;
+    // 按起始地址排序；Block 单独分配，地址在扩容和 trim 时不变
+    std::vector<Entry> index;
+    std::vector<NodeBlocks> nodes;
+    size_type total_slots = 0;
+    size_type used_slots = 0;
+    std::uint64_t expand_calls = 0;
+#if POOL_ALLOCATOR_STATS
+    size_type peak_slots = 0;
+    std::uint64_t free_list_hits = 0;
+#endif
+
+    // 相邻槽位起点的间距；不开检查模式时就是 stride_
+    size_type pitch() const noexcept { return stride_ + slot_redzone(align_); }
+
+    void free_block(const Block& b) noexcept {
+        asan_unpoison(b.base, sizer.block_bytes(b.slots, pitch()));
+        sizer.deallocate_block(b.base, align_);
+    }
+
+    // 新块至少要放下的槽位数：有预留额度时一次用完
+    size_type take_credit() noexcept {
+        if (!credit_ || *credit_ == 0) return 1;
+        size_type count = *credit_;
+        *credit_ = 0;
+        return count;
+    }
+
+    NodeBlocks& node_blocks(unsigned node) {
+        if (node >= nodes.size()) nodes.resize(node + 1);
+        return nodes[node];
+    }
+
+    static unsigned bin_of(size_type free_slots) noexcept {
+        return highest_set_bit(free_slots);
+    }
+
+    // 按当前空位数挂进所属节点的分级链表头部
+    void link(Block& b) noexcept {
+        NodeBlocks& n = nodes[b.node];
+        unsigned k = bin_of(b.slots - b.used);
+        b.bin = k;
+        b.prev = nullptr;
+        b.next = n.partial[k];
+        if (b.next) b.next->prev = &b;
+        n.partial[k] = &b;
+        n.nonempty |= size_type(1) << k;
+    }
+
+    void unlink(Block& b) noexcept {
+        if (b.bin == unlisted || b.bin == current_bin) return;
+        NodeBlocks& n = nodes[b.node];
+        if (b.prev) b.prev->next = b.next;
+        else n.partial[b.bin] = b.next;
+        if (b.next) b.next->prev = b.prev;
+        if (!n.partial[b.bin]) n.nonempty &= ~(size_type(1) << b.bin);
+        b.bin = unlisted;
+    }
+
+    // 取出空位最少的一级里的一个块（同一级内不再比较）；没有时返回 nullptr
+    Block* take_fullest(NodeBlocks& n) noexcept {
+        if (!n.nonempty) return nullptr;
+        Block* b = n.partial[lowest_set_bit(n.nonempty)];
+        unlink(*b);
+        return b;
+    }
+
+    Block* block_of(const Slot* s) const noexcept {
+        const char* p = reinterpret_cast<const char*>(s);
+        auto it = std::upper_bound(index.begin(), index.end(), p,
+                                   [](const char* q, const Entry& e) { return q < e.base; });
+        return std::prev(it)->block.get();
+    }
+
+    // 申请一个至少 count 个槽位的新块，按地址插入 index，挂进 node 的分级链表
+    void expand(size_type count, unsigned node) {
+        ++expand_calls;
+        size_type block_slots = sizer.next_block_slots(count, pitch());
+        index.reserve(index.size() + 1);
+        node_blocks(node);
+        std::unique_ptr<Block> b(new Block{nullptr, block_slots, 0, 0, nullptr, node, unlisted, nullptr, nullptr});
+        size_type bytes = sizer.block_bytes(block_slots, pitch());
+        b->base = static_cast<char*>(sizer.allocate_block(bytes, align_, node));
+        // 还没切出去的槽位和页尾不可访问
+        asan_poison(b->base, bytes);
+        link(*b);
+        auto at = std::upper_bound(index.begin(), index.end(), b->base,
+                                   [](const char* q, const Entry& e) { return q < e.base; });
+        char* base = b->base;
+        index.insert(at, Entry{base, std::move(b)});
+        total_slots += block_slots;
+    }
+
+#if POOL_ALLOCATOR_CHECKED
+    unsigned char* redzone(Slot* s) const noexcept { return reinterpret_cast<unsigned char*>(s) + stride_; }
+
+    // 交给用户之前：填 0xCD，写金丝雀和在用状态，红区对 ASan 不可访问
+    void arm(Slot* s) const noexcept {
+        unsigned char* rz = redzone(s);
+        asan_unpoison(rz, slot_redzone(align_));
+        std::memset(s, allocated_byte, stride_);
+        store_word(rz, canary_value);
+        store_word(rz + sizeof(std::uint64_t), live_magic);
+        asan_poison(rz, slot_redzone(align_));
+    }
+
+    // 收回之前核对金丝雀和状态；通过的槽位填 0xDD 并标成空闲
+    bool disarm(Slot* s) const noexcept {
+        unsigned char* rz = redzone(s);
+        asan_unpoison(rz, slot_redzone(align_));
+        std::uint64_t canary = load_word(rz);
+        std::uint64_t state = load_word(rz + sizeof(std::uint64_t));
+        const char* problem = nullptr;
+        if (state == freed_magic)
+            problem = "double free";
+        else if (canary != canary_value)
+            problem = "write past the end of a slot (canary overwritten)";
+        else if (state != live_magic)
+            problem = "slot header overwritten";
+        if (problem) {
+            asan_poison(rz, slot_redzone(align_));
+            report_corruption(problem, s);
+            return false;
+        }
+        std::memset(s, freed_byte, stride_);
+        store_word(rz + sizeof(std::uint64_t), freed_magic);
+        asan_poison(rz, slot_redzone(align_));
+        return true;
+    }
+
+    // 从空闲链表取出的槽位：除了链表指针以外应当还是 0xDD，链表指针应当指向本块内的空闲槽位
+    void check_freed(Block& b, Slot* s) const noexcept {
+        unsigned char* rz = redzone(s);
+        asan_unpoison(rz, slot_redzone(align_));
+        bool intact = load_word(rz) == canary_value && load_word(rz + sizeof(std::uint64_t)) == freed_magic;
+        asan_poison(rz, slot_redzone(align_));
+        if (!intact || !filled_with(s + 1, stride_ - sizeof(Slot), freed_byte))
+            report_corruption("write after free", s);
+        if (b.free && !in_carved(b, b.free)) {
+            report_corruption("free list corrupted (write after free)", s);
+            b.free = nullptr;
+        }
+    }
+
+    bool in_carved(const Block& b, const Slot* s) const noexcept {
+        const char* p = reinterpret_cast<const char*>(s);
+        if (p < b.base) return false;
+        size_type off = static_cast<size_type>(p - b.base);
+        return off % pitch() == 0 && off / pitch() < b.carved;
+    }
+
+    // 找 p 所属的块；p 不是这个池切出去的槽位起点时报告并返回 nullptr
+    Block* checked_block_of(const Slot* s) const noexcept {
+        const char* p = reinterpret_cast<const char*>(s);
+        if (!index.empty() && p >= index.front().base) {
+            Block* b = block_of(s);
+            if (in_carved(*b, s)) return b;
+            if (static_cast<size_type>(p - b->base) < b->slots * pitch()) {
+                report_corruption("pointer into the middle of a slot or to a slot never handed out", s);
+                return nullptr;
+            }
+        }
+        report_corruption("pointer not allocated from this pool (wrong allocator or wrong n?)", s);
+        return nullptr;
+    }
+#endif
+};
+
+// n > 1 的数组分配：按 2 的幂分级缓存。
+// 每块前面带一个头，记录所属级别，deallocate 为 O(1)；
+// 释放的块挂回对应级别的空闲链表，SimpleSeq 反复扩容时可直接复用。
+// 缓存的块统一按 64 字节对齐（足够放 SIMD/缓存行对齐的数组）；
+// 对齐要求更高或者超过 16 MiB 的块不缓存，释放时直接归还。
+// 检查模式下块头里记着在用 / 空闲状态，用户数据末尾有金丝雀，释放时核对大小。
+class LargeBins {
+public:
+    static constexpr size_type cached_align = 64;
+
+    LargeBins() = default;
+    LargeBins(const LargeBins&) = delete;
+    LargeBins& operator=(const LargeBins&) = delete;
+
+    ~LargeBins() noexcept { release_all(); }
+
+    void* allocate(size_type bytes, size_type align = alignof(std::max_align_t)) {
+#if POOL_ALLOCATOR_STATS
+        ++stats_.large_allocations;
+        stats_.large_live_bytes += bytes;
+        stats_.large_peak_bytes = std::max(stats_.large_peak_bytes, stats_.large_live_bytes);
+#endif
+        size_type a = std::max(align, cached_align);
+        if (a != cached_align || bytes > max_cached_bytes - cached_align - tail_canary_bytes)
+            return allocate_uncached(bytes, a);
+        size_type cls = class_of(bytes + cached_align + tail_canary_bytes);
+        if (Slot* s = bins[cls]) {
+            asan_unpoison(s, sizeof(Slot));
+            bins[cls] = s->next;
+            Header* h = header_of(s);
+#if POOL_ALLOCATOR_CHECKED
+            check_freed(h);
+#endif
+            h->bytes = bytes;
+            arm(h);
+#if POOL_ALLOCATOR_STATS
+            ++stats_.large_bin_hits;
+#endif
+            return s;
+        }
+        return new_chunk(size_type(1) << cls, cls, cached_align, bytes);
+    }
+
+    // bytes 字节的请求实际拿到的块里可用的字节数（级别内剩余的空间也算上）
+    static constexpr size_type usable_bytes(size_type bytes) noexcept {
+        if (bytes > max_cached_bytes - cached_align - tail_canary_bytes) return bytes;
+        return (size_type(1) << class_of(bytes + cached_align + tail_canary_bytes)) - cached_align - tail_canary_bytes;
+    }
+
+    // 块大小是 2 的幂，通常比请求的多出一截：新大小还放得下就原地扩容
+    bool try_expand(void* p, size_type new_bytes) noexcept {
+        Header* h = header_of(p);
+        if (h->size_class == uncached) return false;
+        if (new_bytes > (size_type(1) << h->size_class) - h->align - tail_canary_bytes) return false;
+#if POOL_ALLOCATOR_STATS
+        stats_.large_live_bytes += new_bytes - h->bytes;
+        stats_.large_peak_bytes = std::max(stats_.large_peak_bytes, stats_.large_live_bytes);
+#endif
+#if POOL_ALLOCATOR_CHECKED
+        if (!tail_intact(h)) report_corruption("write past the end of a large block (canary overwritten)", p);
+#endif
+        size_type old_bytes = h->bytes;
+        h->bytes = new_bytes;
+        // 新增的部分和原来一样是未初始化内存
+        asan_unpoison(static_cast<char*>(p) + old_bytes, new_bytes - old_bytes + tail_canary_bytes);
+#if POOL_ALLOCATOR_CHECKED
+        std::memset(static_cast<char*>(p) + old_bytes, allocated_byte, new_bytes - old_bytes);
+#endif
+        protect_tail(h);
+        return true;
+    }
+
+    // bytes 是分配时的大小（原地扩容过的按扩容后的），只在检查模式下核对；0 表示不核对
+    void deallocate(void* p, size_type bytes = 0) noexcept {
+        Header* h = header_of(p);
+#if POOL_ALLOCATOR_CHECKED
+        if (!disarm(h, bytes)) return;
+#else
+        (void)bytes;
+#endif
+#if POOL_ALLOCATOR_STATS
+        stats_.large_live_bytes -= h->bytes;
+#endif
+        if (h->size_class == uncached) {
+            unlink(h);
+            free_chunk(h);
+            return;
+        }
+        Slot* s = static_cast<Slot*>(p);
+        s->next = bins[h->size_class];
+        bins[h->size_class] = s;
+        asan_poison(p, chunk_bytes(h) - h->align);
+    }
+
+    // 归还缓存在各级空闲链表里的块，返回归还的字节数；在用的块不受影响
+    size_type trim() noexcept {
+        size_type released = 0;
+        for (size_type cls = min_class; cls <= max_class; ++cls) {
+            while (Slot* s = bins[cls]) {
+                asan_unpoison(s, sizeof(Slot));
+                bins[cls] = s->next;
+                Header* h = header_of(s);
+                unlink(h);
+                free_chunk(h);
+                released += size_type(1) << cls;
+            }
+        }
+        return released;
+    }
+
+    void release_all() noexcept {
+        Header* h = chunks;
+        while (h) {
+            Header* next = h->next;
+            free_chunk(h);
+            h = next;
+        }
+        chunks = nullptr;
+        std::fill(std::begin(bins), std::end(bins), nullptr);
+#if POOL_ALLOCATOR_STATS
+        stats_.large_live_bytes = 0;
+#endif
+    }
+
+    void add_stats(PoolStats& s) const noexcept {
+#if POOL_ALLOCATOR_STATS
+        s.large_allocations = stats_.large_allocations;
+        s.large_bin_hits = stats_.large_bin_hits;
+        s.large_live_bytes = stats_.large_live_bytes;
+        s.large_peak_bytes = stats_.large_peak_bytes;
+#else
+        (void)s;
+#endif
+    }
+
+private:
+    // 头紧贴在用户指针前面；块起始地址 = 用户指针 - align
+    struct Header {
+        Header* prev;
+        Header* next;
+        size_type size_class;
+        size_type align;
+        size_type bytes;
+#if POOL_ALLOCATOR_CHECKED
+        std::uint64_t magic;
+#endif
+    };
+    static_assert(sizeof(Header) <= cached_align, "LargeBins header must fit in the payload offset");
+
+    static constexpr size_type min_class = 7;
+    static constexpr size_type max_class = 24;
+    static constexpr size_type max_cached_bytes = size_type(1) << max_class;
+    static constexpr size_type uncached = ~size_type(0);
+
+    // bins[k] 缓存大小为 2^k 的块（含头）
+    Slot* bins[max_class + 1] = {};
+    // 所有申请过的块，release_all 时统一归还
+    Header* chunks = nullptr;
+#if POOL_ALLOCATOR_STATS
+    PoolStats stats_;
+#endif
+
+    static constexpr size_type class_of(size_type bytes) noexcept {
+        size_type cls = min_class;
+        while ((size_type(1) << cls) < bytes) ++cls;
+        return cls;
+    }
+
+    static void* payload(Header* h) noexcept {
+        return reinterpret_cast<char*>(h) + sizeof(Header);
+    }
+
+    static Header* header_of(void* p) noexcept {
+        return reinterpret_cast<Header*>(static_cast<char*>(p) - sizeof(Header));
+    }
+
+    static char* base_of(Header* h) noexcept {
+        return static_cast<char*>(payload(h)) - h->align;
+    }
+
+    void* new_chunk(size_type chunk_bytes, size_type cls, size_type align, size_type bytes) {
+        char* base = static_cast<char*>(allocate_bytes(chunk_bytes, align));
+        Header* h = reinterpret_cast<Header*>(base + align - sizeof(Header));
+        h->size_class = cls;
+        h->align = align;
+        h->bytes = bytes;
+        h->prev = nullptr;
+        h->next = chunks;
+        if (chunks) chunks->prev = h;
+        chunks = h;
+        arm(h);
+        return payload(h);
+    }
+
+    static size_type chunk_bytes(const Header* h) noexcept {
+        return h->size_class == uncached ? h->bytes + h->align + tail_canary_bytes : size_type(1) << h->size_class;
+    }
+
+    static void free_chunk(Header* h) noexcept {
+        asan_unpoison(payload(h), chunk_bytes(h) - h->align);
+        deallocate_bytes(base_of(h), h->align);
+    }
+
+    void* allocate_uncached(size_type bytes, size_type align) {
+        if (bytes > ~size_type(0) - align - tail_canary_bytes) throw std::bad_alloc();
+        return new_chunk(bytes + align + tail_canary_bytes, uncached, align, bytes);
+    }
+
+    // 用户数据之后到块尾不可访问；检查模式下先在紧跟数据的位置写金丝雀
+    static void protect_tail(Header* h) noexcept {
+        char* end = static_cast<char*>(payload(h)) + h->bytes;
+#if POOL_ALLOCATOR_CHECKED
+        store_word(end, canary_value);
+#endif
+        asan_poison(end, chunk_bytes(h) - h->align - h->bytes);
+    }
+
+    // 块交给用户之前调用：h->bytes 已是这次请求的大小
+    static void arm(Header* h) noexcept {
+        asan_unpoison(payload(h), h->bytes + tail_canary_bytes);
+#if POOL_ALLOCATOR_CHECKED
+        h->magic = live_magic;
+        std::memset(payload(h), allocated_byte, h->bytes);
+#endif
+        protect_tail(h);
+    }
+
+#if POOL_ALLOCATOR_CHECKED
+    static bool tail_intact(Header* h) noexcept {
+        char* end = static_cast<char*>(payload(h)) + h->bytes;
+        asan_unpoison(end, tail_canary_bytes);
+        bool ok = load_word(end) == canary_value;
+        asan_poison(end, tail_canary_bytes);
+        return ok;
+    }
+
+    static bool disarm(Header* h, size_type bytes) noexcept {
+        void* p = payload(h);
+        const char* problem = nullptr;
+        if (h->magic == freed_magic)
+            problem = "double free of a large block";
+        else if (h->magic != live_magic)
+            problem = "pointer is not a large block from this pool (wrong allocator or wrong n?)";
+        else if (bytes != 0 && bytes != h->bytes)
+            problem = "large block freed with a different size than it was allocated with";
+        else if (!tail_intact(h))
+            problem = "write past the end of a large block (canary overwritten)";
+        if (problem) {
+            report_corruption(problem, p);
+            return false;
+        }
+        h->magic = freed_magic;
+        // 链表指针之后的部分填 0xDD，重新分配时检查
+        if (h->bytes > sizeof(Slot))
+            std::memset(static_cast<char*>(p) + sizeof(Slot), freed_byte, h->bytes - sizeof(Slot));
+        return true;
+    }
+
+    static void check_freed(Header* h) noexcept {
+        void* p = payload(h);
+        size_type n = h->bytes > sizeof(Slot) ? h->bytes - sizeof(Slot) : 0;
+        asan_unpoison(p, h->bytes);
+        if (h->magic != freed_magic || !filled_with(static_cast<char*>(p) + sizeof(Slot), n, freed_byte))
+            report_corruption("write after free of a large block", p);
+    }
+#endif
+
+    void unlink(Header* h) noexcept {
+        if (h->prev) h->prev->next = h->next;
+        else chunks = h->next;
+        if (h->next) h->next->prev = h->prev;
+    }
+};
+
+// 所有拷贝和 rebind 得到的 PoolAllocator 共享的池状态。
+// 按节点大小（槽位步长 + 对齐）分桶。reserve_first() 记下的对象数是一次性额度，
+// 由第一个需要新块的桶用掉：std::map 等 rebind 到节点类型后，首批插入直接命中预留的内存，
+// 而分配器原来的 value_type 桶和之后的其他桶都不会多占。
+class PoolState {
+public:
+    explicit PoolState(const PoolOptions& options = PoolOptions()) noexcept : options_(options) {}
+    PoolState(const PoolState&) = delete;
+    PoolState& operator=(const PoolState&) = delete;
+
+    ~PoolState() noexcept { release_all(); }
+
+    SlabPool* pool_for(size_type stride, size_type align) {
+        for (auto& p : pools)
+            if (p->stride() == stride && p->align() == align) return p.get();
+        pools.push_back(std::make_unique<SlabPool>(stride, align, options_, &reserve_credit));
+        return pools.back().get();
+    }
+
+    // 只给指定的桶预留
+    void reserve(SlabPool* pool, size_type count) {
+        pool->reserve(count);
+    }
+
+    // 给第一个需要新块的桶预留 count 个槽位；多次调用取最大值
+    void reserve_first(size_type count) noexcept {
+        reserve_credit = std::max(reserve_credit, count);
+    }
+
+    void* allocate_large(size_type bytes, size_type align) {
+        return large.allocate(bytes, align);
+    }
+
+    void deallocate_large(void* p, size_type bytes = 0) noexcept {
+        large.deallocate(p, bytes);
+    }
+
+    bool try_expand_large(void* p, size_type new_bytes) noexcept {
+        return large.try_expand(p, new_bytes);
+    }
+
+    void release_all() noexcept {
+        for (auto& p : pools) p->release_all();
+        large.release_all();
+    }
+
+    size_type trim() noexcept {
+        size_type released = large.trim();
+        for (auto& p : pools) released += p->trim();
+        return released;
+    }
+
+    void record_request(size_type bytes) noexcept {
+#if POOL_ALLOCATOR_HISTOGRAM
+        size_type k = 0;
+        while (k + 1 < PoolStats::histogram_bins && (size_type(1) << k) < bytes) ++k;
+        ++histogram[k];
+#else
+        (void)bytes;
+#endif
+    }
+
+    PoolStats stats() const {
+        PoolStats s;
+        for (auto& p : pools) {
+            PoolBucketStats b = p->stats();
+            s.total_slots += b.total_slots;
+            s.live_slots += b.live_slots;
+            s.live_bytes += b.live_slots * b.stride;
+            s.peak_slots += b.peak_slots;
+            s.peak_bytes += b.peak_slots * b.stride;
+            s.block_count += b.block_count;
+            s.empty_blocks += b.empty_blocks;
+            s.free_list_hits += b.free_list_hits;
+            s.expand_calls += b.expand_calls;
+            s.buckets.push_back(b);
+        }
+        large.add_stats(s);
+        s.live_bytes += s.large_live_bytes;
+        s.peak_bytes += s.large_peak_bytes;
+#if POOL_ALLOCATOR_HISTOGRAM
+        std::copy(std::begin(histogram), std::end(histogram), std::begin(s.size_histogram));
+#endif
+        return s;
+    }
+
+private:
+    // unique_ptr 保证已交给分配器的 SlabPool* 在扩容后依然有效
+    PoolOptions options_;
+    std::vector<std::unique_ptr<SlabPool>> pools;
+    LargeBins large;
+    size_type reserve_credit = 0;
+#if POOL_ALLOCATOR_HISTOGRAM
+    std::uint64_t histogram[PoolStats::histogram_bins] = {};
+#endif
+};
+
+} // namespace pool_detail
+
+// SimpleSeq 的增长策略：翻倍后把容量向上取整到 PoolAllocator 大块级别能放下的元素数，
+// 这样本来就会浪费掉的级别内空间直接算作容量。
+template <std::size_t MinCapacity = 2>
+struct PoolSizeClassGrowth {
+    static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t elem_size) noexcept {
+        std::size_t n = std::max({capacity * 2, required, MinCapacity});
+        if (n > ~std::size_t(0) / elem_size) return n;
+        return std::max(n, pool_detail::LargeBins::usable_bytes(n * elem_size) / elem_size);
+    }
+};
 
 template <typename T>
 class PoolAllocator {
@@ -18,122 +1042,134 @@ public:
 
     template <class U> struct rebind { using other = PoolAllocator<U>; };
 
-    PoolAllocator(size_type initial_capacity = 0) noexcept {
+    // 默认构造不分配：共享状态推迟到第一次分配或第一次被拷贝时才建，
+    // 只用内联存储的 SmallSeq 等因此完全不碰堆。还没建状态的分配器之间比较相等（都不拥有内存）
+    PoolAllocator() noexcept = default;
+
+    PoolAllocator(size_type initial_capacity, const PoolOptions& options = PoolOptions())
+        : state_(std::make_shared<pool_detail::PoolState>(options)) {
         if (initial_capacity > 0) reserve(initial_capacity);
     }
 
-    PoolAllocator(const PoolAllocator& other) noexcept {
-    }
+    // 拷贝必须和原对象共享同一个池，所以先替原对象把状态建出来；
+    // 分配器的拷贝不允许抛异常，这里内存不足时 terminate
+    PoolAllocator(const PoolAllocator& other) noexcept : state_(other.shared_state()), slab_(other.slab_) {}
 
-    template <class U>
-    PoolAllocator(const PoolAllocator<U>&) noexcept {
+    // 移动只转交指针，不替原对象建状态；原对象保持原样
+    PoolAllocator(PoolAllocator&& other) noexcept : state_(other.state_), slab_(other.slab_) {}
+
+    PoolAllocator& operator=(const PoolAllocator& other) noexcept {
+        state_ = other.shared_state();
+        slab_ = other.slab_;
+        return *this;
     }
 
-    PoolAllocator(PoolAllocator&& other) noexcept {
-        blocks = std::move(other.blocks);
-        free_list = other.free_list;
-        total_slots = other.total_slots;
-        used_slots = other.used_slots;
-        other.free_list = nullptr;
-        other.total_slots = other.used_slots = 0;
+    PoolAllocator& operator=(PoolAllocator&& other) noexcept {
+        state_ = other.state_;
+        slab_ = other.slab_;
+        return *this;
     }
 
-    ~PoolAllocator() noexcept {
-        release_all();
+    // rebind 共享同一个池；找桶失败时推迟到第一次 allocate 再找，保持 noexcept
+    template <class U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : state_(other.shared_state()) {
+        try {
+            slab_ = state_->pool_for(stride, align);
+        } catch (...) {
+            slab_ = nullptr;
+        }
     }
 
     pointer allocate(size_type n) {
         if (n == 0) return nullptr;
+#if POOL_ALLOCATOR_HISTOGRAM
+        state().record_request(n * sizeof(T));
+#endif
+        pointer p;
         if (n == 1) {
-            if (free_list) {
-                Slot* s = free_list;
-                free_list = s->next;
-                ++used_slots;
-                return reinterpret_cast<pointer>(s);
-            }
-            if (!ensure_free_slot()) {
-                expand(std::max<size_type>(1, default_block_size));
-            }
-            Slot* s = pop_from_block();
-            ++used_slots;
-            return reinterpret_cast<pointer>(s);
+            p = static_cast<pointer>(slab()->allocate());
         } else {
-            size_type bytes = n * sizeof(T);
-            void* p = std::malloc(bytes);
-            if (!p) throw std::bad_alloc();
-            large_allocs.push_back(p);
-            return reinterpret_cast<pointer>(p);
+            if (n > max_size()) throw std::bad_array_new_length();
+            p = static_cast<pointer>(state().allocate_large(n * sizeof(T), alignof(T)));
         }
+#if POOL_ALLOCATOR_TRACE
+        pool_detail::trace_event(AllocTraceKind::allocate, p, n, sizeof(T), alignof(T));
+#endif
+        return p;
     }
 
     void deallocate(pointer p, size_type n) noexcept {
         if (!p) return;
+#if POOL_ALLOCATOR_TRACE
+        pool_detail::trace_event(AllocTraceKind::deallocate, p, n, sizeof(T), alignof(T));
+#endif
         if (n == 1) {
-            Slot* s = reinterpret_cast<Slot*>(p);
-            s->next = free_list;
-            free_list = s;
-            --used_slots;
+            slab()->deallocate(p);
         } else {
-            auto it = std::find(large_allocs.begin(), large_allocs.end(), reinterpret_cast<void*>(p));
-            if (it != large_allocs.end()) {
-                std::free(*it);
-                large_allocs.erase(it);
-            }
+            state_->deallocate_large(p, n * sizeof(T));
         }
     }
 
+    size_type max_size() const noexcept { return ~size_type(0) / sizeof(T); }
+
+    // 尝试把 allocate(old_n) 得到的 p 原地扩成 new_n 个元素；成功后按 new_n 释放
+    bool try_expand(pointer p, size_type old_n, size_type new_n) noexcept {
+        if (!p || old_n <= 1 || new_n <= old_n || new_n > max_size()) return false;
+#if POOL_ALLOCATOR_TRACE
+        if (!state_->try_expand_large(p, new_n * sizeof(T))) return false;
+        pool_detail::trace_event(AllocTraceKind::expand, p, new_n, sizeof(T), alignof(T));
+        return true;
+#else
+        return state_->try_expand_large(p, new_n * sizeof(T));
+#endif
+    }
+
+    // 预留额度留给第一个真正分配对象的桶（通常是容器 rebind 出的节点类型），不一定是 T 的桶
     void reserve(size_type new_cap) {
-        if (new_cap <= total_slots) return;
-        expand(new_cap - total_slots);
+        state().reserve_first(new_cap);
     }
 
     void release_all() noexcept {
-        for (void* b : blocks) std::free(b);
-        blocks.clear();
-        for (void* p : large_allocs) std::free(p);
-        large_allocs.clear();
-        free_list = nullptr;
-        total_slots = used_slots = 0;
+        if (state_) state_->release_all();
     }
 
-    bool operator==(const PoolAllocator& other) const noexcept { return this == &other; }
-    bool operator!=(const PoolAllocator& other) const noexcept { return !(*this == other); }
+    // 把完全空闲的块和缓存着的大块还给系统，返回归还的字节数；已分配的对象不受影响
+    size_type trim() noexcept {
+        return state_ ? state_->trim() : 0;
+    }
+
+    // 整个共享池（所有 rebind 出来的桶）的统计
+    PoolStats stats() const { return state_ ? state_->stats() : PoolStats(); }
+
+    void dump_stats(std::ostream& os) const { dump_pool_stats(stats(), os); }
+
+    template <class U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept { return state_ == other.state_; }
+    template <class U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept { return !(*this == other); }
 
 private:
-    struct Slot { Slot* next; };
-    Slot* free_list = nullptr;
+    template <class U> friend class PoolAllocator;
 
-    std::vector<void*> blocks;
-    std::vector<void*> large_allocs;
-    size_type total_slots = 0;
-    size_type used_slots = 0;
+    static constexpr size_type stride = pool_detail::slot_stride(sizeof(T), alignof(T));
+    static constexpr size_type align = pool_detail::slot_align(alignof(T));
 
-    static constexpr size_type default_block_size = 16;
+    // 拷贝 const 的分配器时也可能要建状态，所以是 mutable；PoolAllocator 本来就不能跨线程共用
+    mutable std::shared_ptr<pool_detail::PoolState> state_;
+    pool_detail::SlabPool* slab_ = nullptr;
 
-    void expand(size_type count) {
-        size_type block_slots = std::max(count, default_block_size);
-        size_type bytes = block_slots * sizeof(T);
-        void* raw = std::malloc(bytes);
-        if (!raw) throw std::bad_alloc();
-        blocks.push_back(raw);
-        char* base = reinterpret_cast<char*>(raw);
-        for (size_type i = 0; i < block_slots; ++i) {
-            Slot* s = reinterpret_cast<Slot*>(base + i * sizeof(T));
-            s->next = free_list;
-            free_list = s;
-        }
-        total_slots += block_slots;
+    pool_detail::PoolState& state() {
+        if (!state_) state_ = std::make_shared<pool_detail::PoolState>();
+        return *state_;
     }
 
-    bool ensure_free_slot() {
-        if (free_list) return true;
-        expand(default_block_size);
-        return free_list != nullptr;
+    const std::shared_ptr<pool_detail::PoolState>& shared_state() const noexcept {
+        if (!state_) state_ = std::make_shared<pool_detail::PoolState>();
+        return state_;
     }
 
-    Slot* pop_from_block() {
-        Slot* s = free_list;
-        free_list = s->next;
-        return s;
+    pool_detail::SlabPool* slab() {
+        if (!slab_) slab_ = state().pool_for(stride, align);
+        return slab_;
     }
 };
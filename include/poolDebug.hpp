@@ -0,0 +1,114 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// 检查模式（编译期开关 POOL_ALLOCATOR_CHECKED=1），用来在压力下定位内存破坏：
+// - 每个 slab 槽位后面多一段红区，放一个金丝雀值和槽位状态（在用 / 空闲）；
+//   大块在用户数据末尾放金丝雀，块头里记状态；
+// - deallocate 检查指针是否属于这个池、是否落在槽位起点、是否重复释放、金丝雀是否完好，
+//   大块还核对释放时给的大小；
+// - 新分配的内存填 0xCD，释放的内存填 0xDD，再次分配前检查 0xDD 是否被改写（释放后写入）；
+// - 发现问题时调用 set_pool_corruption_handler() 设置的处理函数，默认打印到 stderr 后 abort；
+//   处理函数返回的话，这次出问题的释放被忽略，池的内部结构不会被进一步破坏。
+// 用 AddressSanitizer 编译时（不论是否打开检查模式），空闲槽位、缓存的空闲大块、
+// 大块末尾和还没切出的槽位都会被标记为不可访问，越界和释放后访问由 ASan 当场报告。
+// 两者都关闭时，这里的函数都是空的，热路径与原来完全相同。
+
+#ifndef POOL_ALLOCATOR_CHECKED
+#define POOL_ALLOCATOR_CHECKED 0
+#endif
+
+#ifndef POOL_ALLOCATOR_ASAN
+#if defined(__SANITIZE_ADDRESS__)
+#define POOL_ALLOCATOR_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define POOL_ALLOCATOR_ASAN 1
+#endif
+#endif
+#endif
+#ifndef POOL_ALLOCATOR_ASAN
+#define POOL_ALLOCATOR_ASAN 0
+#endif
+#if POOL_ALLOCATOR_ASAN
+#include <sanitizer/asan_interface.h>
+#endif
+
+// what 是问题的简短描述，p 是出问题的指针；处理函数不能抛异常
+using PoolCorruptionHandler = void (*)(const char* what, const void* p);
+
+namespace pool_detail {
+
+inline void default_corruption_handler(const char* what, const void* p) {
+    std::fprintf(stderr, "pool allocator: %s (pointer %p)\n", what, p);
+    std::abort();
+}
+
+inline std::atomic<PoolCorruptionHandler>& corruption_handler() noexcept {
+    static std::atomic<PoolCorruptionHandler> handler{&default_corruption_handler};
+    return handler;
+}
+
+inline void report_corruption(const char* what, const void* p) noexcept {
+    corruption_handler().load(std::memory_order_acquire)(what, p);
+}
+
+inline void asan_poison(const void* p, std::size_t bytes) noexcept {
+#if POOL_ALLOCATOR_ASAN
+    ASAN_POISON_MEMORY_REGION(p, bytes);
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
+
+inline void asan_unpoison(const void* p, std::size_t bytes) noexcept {
+#if POOL_ALLOCATOR_ASAN
+    ASAN_UNPOISON_MEMORY_REGION(p, bytes);
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
+
+constexpr unsigned char allocated_byte = 0xCD;
+constexpr unsigned char freed_byte = 0xDD;
+constexpr std::uint64_t canary_value = 0xC0DEFACEFEEDC0DEull;
+constexpr std::uint64_t live_magic = 0x4556494C4C4F4F50ull;  // "POOLLIVE"
+constexpr std::uint64_t freed_magic = 0x454552464C4F4F50ull; // "POOLFREE"
+
+// 检查模式下每个 slab 槽位后面的红区：金丝雀 + 状态，按槽位对齐取整
+constexpr std::size_t slot_redzone(std::size_t align) noexcept {
+    return POOL_ALLOCATOR_CHECKED ? (align > 16 ? align : 16) : 0;
+}
+
+// 检查模式下大块末尾的金丝雀
+constexpr std::size_t tail_canary_bytes = POOL_ALLOCATOR_CHECKED ? sizeof(std::uint64_t) : 0;
+
+// 红区和块尾不一定按 8 字节对齐，用 memcpy 读写
+inline std::uint64_t load_word(const void* p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void store_word(void* p, std::uint64_t v) noexcept { std::memcpy(p, &v, sizeof(v)); }
+
+inline bool filled_with(const void* p, std::size_t bytes, unsigned char byte) noexcept {
+    const unsigned char* c = static_cast<const unsigned char*>(p);
+    for (std::size_t i = 0; i < bytes; ++i)
+        if (c[i] != byte) return false;
+    return true;
+}
+
+} // namespace pool_detail
+
+// 设置检查模式发现内存破坏时的处理函数，返回原来的；传 nullptr 恢复默认（打印后 abort）
+inline PoolCorruptionHandler set_pool_corruption_handler(PoolCorruptionHandler handler) noexcept {
+    if (!handler) handler = &pool_detail::default_corruption_handler;
+    return pool_detail::corruption_handler().exchange(handler, std::memory_order_acq_rel);
+}
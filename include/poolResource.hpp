@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include "poolAllocator.hpp"
+
+// 基于 PoolAllocator 同一套 slab / 空闲链表实现的 std::pmr::memory_resource。
+// pmr::map、pmr::vector 以及用 polymorphic_allocator 的 SimpleSeq 可以共用一个池，
+// 不用为每种容器实例化一份 PoolAllocator<T>。
+// - 不超过 small_limit 字节的请求按 16 字节取整后走对应大小的 slab；
+// - 更大的请求走 LargeBins 的 2 的幂分级缓存。
+// PoolResource 不加锁；SynchronizedPoolResource 用一把互斥锁保护，可跨线程共享。
+
+namespace pool_detail {
+
+struct NullMutex {
+    void lock() noexcept {}
+    void unlock() noexcept {}
+};
+
+} // namespace pool_detail
+
+template <class Mutex>
+class BasicPoolResource : public std::pmr::memory_resource {
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type small_granularity = 16;
+    static constexpr size_type small_limit = 512;
+
+    explicit BasicPoolResource(const PoolOptions& options = PoolOptions()) noexcept : state_(options) {}
+
+    BasicPoolResource(const BasicPoolResource&) = delete;
+    BasicPoolResource& operator=(const BasicPoolResource&) = delete;
+
+    // 预先给大小为 bytes 的对象准备 count 个槽位
+    void reserve(size_type bytes, size_type count, size_type align = alignof(std::max_align_t)) {
+        std::lock_guard<Mutex> lock(mutex_);
+        if (bytes > small_limit) return;
+        state_.reserve(bucket(bytes, align), count);
+    }
+
+    void release() noexcept {
+        std::lock_guard<Mutex> lock(mutex_);
+        state_.release_all();
+    }
+
+    // 归还完全空闲的块，返回字节数
+    size_type trim() noexcept {
+        std::lock_guard<Mutex> lock(mutex_);
+        return state_.trim();
+    }
+
+    PoolStats stats() const {
+        std::lock_guard<Mutex> lock(mutex_);
+        return state_.stats();
+    }
+
+    void dump_stats(std::ostream& os) const { dump_pool_stats(stats(), os); }
+
+protected:
+    void* do_allocate(size_type bytes, size_type align) override {
+        std::lock_guard<Mutex> lock(mutex_);
+#if POOL_ALLOCATOR_HISTOGRAM
+        state_.record_request(bytes);
+#endif
+        void* p = bytes > small_limit ? state_.allocate_large(bytes, align) : bucket(bytes, align)->allocate();
+#if POOL_ALLOCATOR_TRACE
+        trace(AllocTraceKind::allocate, p, bytes, align);
+#endif
+        return p;
+    }
+
+    void do_deallocate(void* p, size_type bytes, size_type align) override {
+        std::lock_guard<Mutex> lock(mutex_);
+#if POOL_ALLOCATOR_TRACE
+        trace(AllocTraceKind::deallocate, p, bytes, align);
+#endif
+        if (bytes > small_limit) {
+            state_.deallocate_large(p, bytes);
+            return;
+        }
+        bucket(bytes, align)->deallocate(p);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    static constexpr size_type small_classes = small_limit / small_granularity;
+
+    mutable Mutex mutex_;
+    pool_detail::PoolState state_;
+    // 常规对齐的小对象直接按大小查表，不用在桶列表里线性查找
+    pool_detail::SlabPool* small_[small_classes + 1] = {};
+
+#if POOL_ALLOCATOR_TRACE
+    // 与 PoolAllocator 的记录方式一致：小对象记成 1 个 bytes 大小的元素，大块记成 bytes 个字节
+    static void trace(AllocTraceKind kind, void* p, size_type bytes, size_type align) noexcept {
+        if (bytes > small_limit)
+            pool_detail::trace_event(kind, p, bytes, 1, align);
+        else
+            pool_detail::trace_event(kind, p, 1, bytes, align);
+    }
+#endif
+
+    pool_detail::SlabPool* bucket(size_type bytes, size_type align) {
+        size_type rounded = pool_detail::align_up(std::max<size_type>(bytes, 1), small_granularity);
+        if (align > small_granularity)
+            return state_.pool_for(pool_detail::slot_stride(rounded, align), pool_detail::slot_align(align));
+        size_type cls = rounded / small_granularity;
+        if (!small_[cls])
+            small_[cls] = state_.pool_for(rounded, small_granularity);
+        return small_[cls];
+    }
+};
+
+using PoolResource = BasicPoolResource<pool_detail::NullMutex>;
+using SynchronizedPoolResource = BasicPoolResource<std::mutex>;
@@ -0,0 +1,315 @@
+#pragma once
+#include <memory>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+#include "poolAllocator.hpp"
+#include "simpleSeq.hpp"
+
+// 分段（类 deque）顺序容器：元素放在 ChunkN 个一组的定长块里，块从分配器
+// （默认 PoolAllocator，同样大小的块走同一个 slab）里按整块取。
+// - 只往末尾追加，从不搬迁已有元素：元素地址在其生命期内保持不变；
+// - push_back 的开销与 size() 无关，没有 SimpleSeq 翻倍扩容时的整段拷贝和 3 倍内存峰值；
+// - 只有块指针表放在 SimpleSeq 里，扩容时搬的是指针，不是元素；
+// - 迭代器按块顺序走，块内是连续内存；for_each_segment 直接给出每段 [first, last)。
+// clear() 保留已分配的块留给之后复用，shrink_to_fit() 归还空闲块。
+
+namespace seq_detail {
+
+// 默认每块约 4KB，至少 1 个元素
+template <class T>
+constexpr std::size_t default_chunk_elems = sizeof(T) >= 4096 ? 1 : 4096 / sizeof(T);
+
+} // namespace seq_detail
+
+template <typename T, std::size_t ChunkN = seq_detail::default_chunk_elems<T>,
+          typename Alloc = PoolAllocator<T>>
+class SegmentedSeq {
+    static_assert(ChunkN > 0, "SegmentedSeq needs at least one element per chunk");
+
+    struct Chunk {
+        alignas(T) unsigned char bytes[ChunkN * sizeof(T)];
+        T* data() noexcept { return reinterpret_cast<T*>(bytes); }
+    };
+
+    using alloc_traits = std::allocator_traits<Alloc>;
+    using chunk_alloc = typename alloc_traits::template rebind_alloc<Chunk>;
+    using chunk_traits = std::allocator_traits<chunk_alloc>;
+    using table_type = SimpleSeq<Chunk*, typename alloc_traits::template rebind_alloc<Chunk*>>;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static constexpr size_type chunk_elems = ChunkN;
+
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        basic_iterator() noexcept = default;
+        template <bool C, class = std::enable_if_t<Const && !C>>
+        basic_iterator(const basic_iterator<C>& other) noexcept
+            : node_(other.node_), last_node_(other.last_node_), cur_(other.cur_), chunk_end_(other.chunk_end_) {}
+
+        reference operator*() const noexcept { return *cur_; }
+        pointer operator->() const noexcept { return cur_; }
+
+        // 块内只是指针加一；走到块尾且后面还有块时才换块
+        basic_iterator& operator++() noexcept {
+            if (++cur_ == chunk_end_ && node_ != last_node_) {
+                ++node_;
+                cur_ = (*node_)->data();
+                chunk_end_ = cur_ + ChunkN;
+            }
+            return *this;
+        }
+        basic_iterator operator++(int) noexcept {
+            basic_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        // 还要比较块：相邻的两个块首尾可能相接，上一块的末尾就是下一块的开头
+        friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept {
+            return a.cur_ == b.cur_ && a.node_ == b.node_;
+        }
+        friend bool operator!=(const basic_iterator& a, const basic_iterator& b) noexcept { return !(a == b); }
+
+    private:
+        friend class SegmentedSeq;
+        template <bool> friend class basic_iterator;
+
+        Chunk* const* node_ = nullptr;
+        Chunk* const* last_node_ = nullptr;
+        pointer cur_ = nullptr;
+        pointer chunk_end_ = nullptr;
+
+        basic_iterator(Chunk* const* node, Chunk* const* last_node, pointer cur) noexcept
+            : node_(node), last_node_(last_node), cur_(cur), chunk_end_(cur ? (*node)->data() + ChunkN : nullptr) {}
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    explicit SegmentedSeq(const Alloc& alloc = Alloc())
+        : alloc_(alloc), chunk_alloc_(alloc_), chunks_(0, typename table_type::allocator_type(alloc_)) {}
+
+    SegmentedSeq(const SegmentedSeq& other)
+        : SegmentedSeq(alloc_traits::select_on_container_copy_construction(other.alloc_)) {
+        append_from(other);
+    }
+
+    // 只交接块指针表，元素和块都不动
+    SegmentedSeq(SegmentedSeq&& other) noexcept
+        : alloc_(other.alloc_), chunk_alloc_(other.chunk_alloc_), chunks_(std::move(other.chunks_)),
+          size_(other.size_), tail_(other.tail_), tail_end_(other.tail_end_) {
+        other.forget();
+    }
+
+    ~SegmentedSeq() {
+        release();
+    }
+
+    SegmentedSeq& operator=(const SegmentedSeq& other) {
+        if (this == &other) return *this;
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) release();
+            alloc_ = other.alloc_;
+            chunk_alloc_ = chunk_alloc(alloc_);
+        }
+        clear();
+        append_from(other);
+        return *this;
+    }
+
+    SegmentedSeq& operator=(SegmentedSeq&& other) {
+        if (this == &other) return *this;
+        if (alloc_traits::propagate_on_container_move_assignment::value || alloc_ == other.alloc_) {
+            release();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                alloc_ = other.alloc_;
+                chunk_alloc_ = other.chunk_alloc_;
+            }
+            chunks_ = std::move(other.chunks_);
+            size_ = other.size_;
+            tail_ = other.tail_;
+            tail_end_ = other.tail_end_;
+            other.forget();
+        } else {
+            // 分配器不相等又不传播：块不能换主人，只能逐个移动元素
+            clear();
+            for (T& v : other) emplace_back(std::move(v));
+            other.release();
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    void push_back(const T& v) {
+        emplace_back(v);
+    }
+
+    void push_back(T&& v) {
+        emplace_back(std::move(v));
+    }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        if (tail_ == tail_end_) next_chunk();
+        alloc_traits::construct(alloc_, tail_, std::forward<Args>(args)...);
+        ++size_;
+        return *tail_++;
+    }
+
+    void pop_back() {
+        alloc_traits::destroy(alloc_, --tail_);
+        --size_;
+        // 退到块首时把尾部挪回上一块的末尾，保持“tail_ == tail_end_ 表示当前块已满”
+        size_type idx = size_ / ChunkN;
+        if (size_ && size_ % ChunkN == 0) {
+            tail_end_ = chunks_[idx - 1]->data() + ChunkN;
+            tail_ = tail_end_;
+        }
+    }
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    size_type capacity() const noexcept { return chunks_.size() * ChunkN; }
+    size_type chunk_count() const noexcept { return chunks_.size(); }
+
+    T& operator[](size_type i) noexcept { return chunks_[i / ChunkN]->data()[i % ChunkN]; }
+    const T& operator[](size_type i) const noexcept { return chunks_[i / ChunkN]->data()[i % ChunkN]; }
+    T& front() noexcept { return *chunks_[0]->data(); }
+    const T& front() const noexcept { return *chunks_[0]->data(); }
+    T& back() noexcept { return tail_[-1]; }
+    const T& back() const noexcept { return tail_[-1]; }
+
+    iterator begin() noexcept { return make_begin<iterator>(); }
+    iterator end() noexcept { return make_end<iterator>(); }
+    const_iterator begin() const noexcept { return make_begin<const_iterator>(); }
+    const_iterator end() const noexcept { return make_end<const_iterator>(); }
+
+    // 依次对每段连续元素调用 f(first, last)，内层循环是纯指针遍历，便于编译器向量化
+    template <class F>
+    void for_each_segment(F&& f) {
+        walk_segments<T*>(f);
+    }
+    template <class F>
+    void for_each_segment(F&& f) const {
+        walk_segments<const T*>(f);
+    }
+
+    // 预先分配够 n 个元素的块，之后的 push_back 不再向分配器要内存
+    void reserve(size_type n) {
+        size_type want = (n + ChunkN - 1) / ChunkN;
+        if (want <= chunks_.size()) return;
+        chunks_.reserve(want);
+        while (chunks_.size() < want) chunks_.push_back(chunk_traits::allocate(chunk_alloc_, 1));
+    }
+
+    // 归还没有元素的块
+    void shrink_to_fit() {
+        size_type used = (size_ + ChunkN - 1) / ChunkN;
+        while (chunks_.size() > used) {
+            chunk_traits::deallocate(chunk_alloc_, chunks_[chunks_.size() - 1], 1);
+            chunks_.resize(chunks_.size() - 1);
+        }
+        chunks_.shrink_to_fit();
+        if (chunks_.empty()) tail_ = tail_end_ = nullptr;
+    }
+
+    void clear() noexcept {
+        walk_segments<T*>([this](T* first, T* last) {
+            for (; first != last; ++first) alloc_traits::destroy(alloc_, first);
+        });
+        size_ = 0;
+        tail_ = chunks_.empty() ? nullptr : chunks_[0]->data();
+        tail_end_ = tail_ ? tail_ + ChunkN : nullptr;
+    }
+
+private:
+    Alloc alloc_;
+    chunk_alloc chunk_alloc_;
+    table_type chunks_;
+    size_type size_ = 0;
+    // 下一个元素的位置和当前块的末尾；相等表示需要换到下一块
+    T* tail_ = nullptr;
+    T* tail_end_ = nullptr;
+
+    void next_chunk() {
+        size_type idx = size_ / ChunkN;
+        if (idx == chunks_.size()) {
+            Chunk* c = chunk_traits::allocate(chunk_alloc_, 1);
+            try {
+                chunks_.push_back(c);
+            } catch (...) {
+                chunk_traits::deallocate(chunk_alloc_, c, 1);
+                throw;
+            }
+        }
+        tail_ = chunks_[idx]->data();
+        tail_end_ = tail_ + ChunkN;
+    }
+
+    template <class It>
+    It make_begin() const noexcept {
+        if (size_ == 0) return It();
+        Chunk* const* table = chunks_.data();
+        return It(table, table + (size_ - 1) / ChunkN, table[0]->data());
+    }
+
+    template <class It>
+    It make_end() const noexcept {
+        if (size_ == 0) return It();
+        Chunk* const* last = chunks_.data() + (size_ - 1) / ChunkN;
+        return It(last, last, tail_);
+    }
+
+    template <class P, class F>
+    void walk_segments(F&& f) const {
+        size_type full = size_ / ChunkN;
+        for (size_type i = 0; i < full; ++i) {
+            P first = chunks_[i]->data();
+            f(first, first + ChunkN);
+        }
+        if (size_type rest = size_ % ChunkN) {
+            P first = chunks_[full]->data();
+            f(first, first + rest);
+        }
+    }
+
+    void append_from(const SegmentedSeq& other) {
+        reserve(size_ + other.size_);
+        other.for_each_segment([this](const T* first, const T* last) {
+            for (; first != last; ++first) emplace_back(*first);
+        });
+    }
+
+    void release() noexcept {
+        clear();
+        for (Chunk* c : chunks_) chunk_traits::deallocate(chunk_alloc_, c, 1);
+        chunks_.clear();
+        chunks_.shrink_to_fit();
+        tail_ = tail_end_ = nullptr;
+    }
+
+    // 块已经交给别的 SegmentedSeq，这里只清空记录
+    void forget() noexcept {
+        chunks_.clear();
+        size_ = 0;
+        tail_ = tail_end_ = nullptr;
+    }
+};
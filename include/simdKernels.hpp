@@ -0,0 +1,627 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "simpleSeq.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define POOL_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define POOL_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// 连续区间上的显式向量化扫描：simd_find / simd_count / simd_min / simd_max / simd_sum / simd_fill。
+// - 元素类型为 int32_t、int64_t、float、double 时走向量实现，其他算术类型退回标量循环；
+// - x86-64 上运行时检测：有 AVX-512F 用 512 位，有 AVX2 用 256 位，否则用基线 SSE2；
+//   AArch64 上直接用 NEON。检测只做一次，set_simd_level() 可以手动降级（测试、对比用）；
+//   向量实现依赖 GCC / Clang 的 target 属性和 __builtin_cpu_supports，MSVC（包括 x64）只走标量循环；
+// - PoolAllocator 给的缓冲区按 64 字节对齐，向量加载不会跨缓存行；
+// - simd_sum 对整数按补码回绕（与无符号累加结果相同），对浮点按多路并行累加，舍入与逐个累加可能不同；
+//   含 NaN 时 simd_min / simd_max 的结果不确定；simd_min / simd_max 要求区间非空。
+// 每个函数都有直接传 SimpleSeq 的重载。
+
+enum class SimdLevel { scalar, sse2, avx2, avx512, neon };
+
+namespace simd_detail {
+
+using size_type = std::size_t;
+
+template <class T>
+struct is_vector_type
+    : std::integral_constant<bool, std::is_same<T, std::int32_t>::value || std::is_same<T, std::int64_t>::value ||
+                                       std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+#if defined(POOL_SIMD_X86) || defined(POOL_SIMD_NEON)
+// 只有向量内核用到；两种向量实现都只在 GCC / Clang 下启用
+inline int lowest_lane(unsigned mask) noexcept { return __builtin_ctz(mask); }
+inline int lane_count(unsigned mask) noexcept { return __builtin_popcount(mask); }
+#endif
+
+// 整数按无符号累加，溢出时回绕而不是未定义行为
+template <class T>
+T wrap_add(T a, T b) noexcept {
+    if constexpr (std::is_integral<T>::value) {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+    } else {
+        return a + b;
+    }
+}
+
+// ---- 标量实现，也用来处理向量循环剩下的尾部 ----
+
+template <class T>
+const T* find_scalar(const T* p, const T* e, T x) noexcept {
+    for (; p != e; ++p)
+        if (*p == x) return p;
+    return e;
+}
+
+template <class T>
+size_type count_scalar(const T* p, const T* e, T x) noexcept {
+    size_type n = 0;
+    for (; p != e; ++p) n += *p == x;
+    return n;
+}
+
+template <class T>
+T min_scalar(const T* p, const T* e, T acc) noexcept {
+    for (; p != e; ++p) acc = *p < acc ? *p : acc;
+    return acc;
+}
+
+template <class T>
+T max_scalar(const T* p, const T* e, T acc) noexcept {
+    for (; p != e; ++p) acc = acc < *p ? *p : acc;
+    return acc;
+}
+
+template <class T>
+T sum_scalar(const T* p, const T* e, T acc) noexcept {
+    for (; p != e; ++p) acc = wrap_add(acc, *p);
+    return acc;
+}
+
+template <class T>
+void fill_scalar(T* p, T* e, T x) noexcept {
+    for (; p != e; ++p) *p = x;
+}
+
+// ---- 与指令集无关的向量内核，O 提供 load / store / set1 / eq_mask / min / max / add ----
+// 内核按指令集各展开一份（find_Avx2<T> 等），与 O 的成员函数带同样的 target 属性：
+// 向量参数在不同 target 的函数之间传递时 ABI 不一致，所以同一条调用链上的函数必须属于同一个指令集。
+// min / max 用两路累加器隐藏指令延迟；sum 用四路。
+
+#define POOL_SIMD_KERNELS(NAME, ATTR)                                                                      \
+    template <class T>                                                                                     \
+    ATTR const T* find_##NAME(const T* p, const T* e, T x) noexcept {                                      \
+        using O = NAME<T>;                                                                                 \
+        constexpr std::ptrdiff_t W = O::width;                                                            \
+        auto vx = O::set1(x);                                                                              \
+        for (; e - p >= 2 * W; p += 2 * W) {                                                               \
+            unsigned m0 = O::eq_mask(O::load(p), vx);                                                      \
+            unsigned m1 = O::eq_mask(O::load(p + W), vx);                                                  \
+            if (m0 | m1) return m0 ? p + lowest_lane(m0) : p + W + lowest_lane(m1);                        \
+        }                                                                                                  \
+        for (; e - p >= W; p += W)                                                                         \
+            if (unsigned m = O::eq_mask(O::load(p), vx)) return p + lowest_lane(m);                        \
+        return find_scalar(p, e, x);                                                                       \
+    }                                                                                                      \
+    template <class T>                                                                                     \
+    ATTR size_type count_##NAME(const T* p, const T* e, T x) noexcept {                                    \
+        using O = NAME<T>;                                                                                 \
+        constexpr std::ptrdiff_t W = O::width;                                                            \
+        auto vx = O::set1(x);                                                                              \
+        size_type n = 0;                                                                                   \
+        for (; e - p >= 2 * W; p += 2 * W)                                                                 \
+            n += lane_count(O::eq_mask(O::load(p), vx)) + lane_count(O::eq_mask(O::load(p + W), vx));      \
+        for (; e - p >= W; p += W) n += lane_count(O::eq_mask(O::load(p), vx));                            \
+        return n + count_scalar(p, e, x);                                                                  \
+    }                                                                                                      \
+    template <class T, bool Min>                                                                           \
+    ATTR T extreme_##NAME(const T* p, const T* e) noexcept {                                               \
+        using O = NAME<T>;                                                                                 \
+        constexpr std::ptrdiff_t W = O::width;                                                            \
+        T acc = *p;                                                                                        \
+        if (e - p >= 2 * W) {                                                                              \
+            auto a0 = O::load(p), a1 = O::load(p + W);                                                     \
+            for (p += 2 * W; e - p >= 2 * W; p += 2 * W) {                                                 \
+                a0 = Min ? O::min(a0, O::load(p)) : O::max(a0, O::load(p));                                \
+                a1 = Min ? O::min(a1, O::load(p + W)) : O::max(a1, O::load(p + W));                        \
+            }                                                                                              \
+            alignas(64) T lanes[W];                                                                        \
+            O::store(lanes, Min ? O::min(a0, a1) : O::max(a0, a1));                                        \
+            acc = Min ? min_scalar(lanes + 1, lanes + W, lanes[0]) : max_scalar(lanes + 1, lanes + W, lanes[0]); \
+        }                                                                                                  \
+        return Min ? min_scalar(p, e, acc) : max_scalar(p, e, acc);                                        \
+    }                                                                                                      \
+    template <class T>                                                                                     \
+    ATTR T sum_##NAME(const T* p, const T* e) noexcept {                                                   \
+        using O = NAME<T>;                                                                                 \
+        constexpr std::ptrdiff_t W = O::width;                                                            \
+        auto a0 = O::set1(T(0)), a1 = a0, a2 = a0, a3 = a0;                                                \
+        for (; e - p >= 4 * W; p += 4 * W) {                                                               \
+            a0 = O::add(a0, O::load(p));                                                                   \
+            a1 = O::add(a1, O::load(p + W));                                                               \
+            a2 = O::add(a2, O::load(p + 2 * W));                                                           \
+            a3 = O::add(a3, O::load(p + 3 * W));                                                           \
+        }                                                                                                  \
+        alignas(64) T lanes[W];                                                                            \
+        O::store(lanes, O::add(O::add(a0, a1), O::add(a2, a3)));                                           \
+        return sum_scalar(p, e, sum_scalar(lanes, lanes + W, T(0)));                                       \
+    }                                                                                                      \
+    template <class T>                                                                                     \
+    ATTR void fill_##NAME(T* p, T* e, T x) noexcept {                                                      \
+        using O = NAME<T>;                                                                                 \
+        constexpr std::ptrdiff_t W = O::width;                                                            \
+        auto vx = O::set1(x);                                                                              \
+        for (; e - p >= W; p += W) O::store(p, vx);                                                        \
+        fill_scalar(p, e, x);                                                                              \
+    }
+
+#if defined(POOL_SIMD_X86)
+
+#define POOL_SIMD_AVX2 __attribute__((target("avx2")))
+#define POOL_SIMD_AVX512 __attribute__((target("avx512f")))
+
+// ---- SSE2（x86-64 基线，无需检测）----
+
+template <class T>
+struct Sse2;
+
+template <>
+struct Sse2<std::int32_t> {
+    using T = std::int32_t;
+    using V = __m128i;
+    static constexpr size_type width = 4;
+    static constexpr bool has_minmax = true;
+    static V load(const T* p) noexcept { return _mm_loadu_si128(reinterpret_cast<const V*>(p)); }
+    static void store(T* p, V v) noexcept { _mm_storeu_si128(reinterpret_cast<V*>(p), v); }
+    static V set1(T x) noexcept { return _mm_set1_epi32(x); }
+    static unsigned eq_mask(V a, V b) noexcept { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+    // SSE2 没有 pminsd，用比较结果选择
+    static V min(V a, V b) noexcept {
+        V gt = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+    }
+    static V max(V a, V b) noexcept {
+        V gt = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+    }
+    static V add(V a, V b) noexcept { return _mm_add_epi32(a, b); }
+};
+
+template <>
+struct Sse2<std::int64_t> {
+    using T = std::int64_t;
+    using V = __m128i;
+    static constexpr size_type width = 2;
+    static constexpr bool has_minmax = false;
+    static V load(const T* p) noexcept { return _mm_loadu_si128(reinterpret_cast<const V*>(p)); }
+    static void store(T* p, V v) noexcept { _mm_storeu_si128(reinterpret_cast<V*>(p), v); }
+    static V set1(T x) noexcept { return _mm_set1_epi64x(x); }
+    // 两个 32 位半边都相等才算相等
+    static unsigned eq_mask(V a, V b) noexcept {
+        V eq = _mm_cmpeq_epi32(a, b);
+        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_movemask_pd(_mm_castsi128_pd(eq));
+    }
+    static V min(V a, V) noexcept { return a; }
+    static V max(V a, V) noexcept { return a; }
+    static V add(V a, V b) noexcept { return _mm_add_epi64(a, b); }
+};
+
+template <>
+struct Sse2<float> {
+    using T = float;
+    using V = __m128;
+    static constexpr size_type width = 4;
+    static constexpr bool has_minmax = true;
+    static V load(const T* p) noexcept { return _mm_loadu_ps(p); }
+    static void store(T* p, V v) noexcept { _mm_storeu_ps(p, v); }
+    static V set1(T x) noexcept { return _mm_set1_ps(x); }
+    static unsigned eq_mask(V a, V b) noexcept { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+    static V min(V a, V b) noexcept { return _mm_min_ps(a, b); }
+    static V max(V a, V b) noexcept { return _mm_max_ps(a, b); }
+    static V add(V a, V b) noexcept { return _mm_add_ps(a, b); }
+};
+
+template <>
+struct Sse2<double> {
+    using T = double;
+    using V = __m128d;
+    static constexpr size_type width = 2;
+    static constexpr bool has_minmax = true;
+    static V load(const T* p) noexcept { return _mm_loadu_pd(p); }
+    static void store(T* p, V v) noexcept { _mm_storeu_pd(p, v); }
+    static V set1(T x) noexcept { return _mm_set1_pd(x); }
+    static unsigned eq_mask(V a, V b) noexcept { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+    static V min(V a, V b) noexcept { return _mm_min_pd(a, b); }
+    static V max(V a, V b) noexcept { return _mm_max_pd(a, b); }
+    static V add(V a, V b) noexcept { return _mm_add_pd(a, b); }
+};
+
+// ---- AVX2 ----
+
+template <class T>
+struct Avx2;
+
+template <>
+struct Avx2<std::int32_t> {
+    using T = std::int32_t;
+    using V = __m256i;
+    static constexpr size_type width = 8;
+    static constexpr bool has_minmax = true;
+    POOL_SIMD_AVX2 static V load(const T* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const V*>(p)); }
+    POOL_SIMD_AVX2 static void store(T* p, V v) noexcept { _mm256_storeu_si256(reinterpret_cast<V*>(p), v); }
+    POOL_SIMD_AVX2 static V set1(T x) noexcept { return _mm256_set1_epi32(x); }
+    POOL_SIMD_AVX2 static unsigned eq_mask(V a, V b) noexcept {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+    }
+    POOL_SIMD_AVX2 static V min(V a, V b) noexcept { return _mm256_min_epi32(a, b); }
+    POOL_SIMD_AVX2 static V max(V a, V b) noexcept { return _mm256_max_epi32(a, b); }
+    POOL_SIMD_AVX2 static V add(V a, V b) noexcept { return _mm256_add_epi32(a, b); }
+};
+
+template <>
+struct Avx2<std::int64_t> {
+    using T = std::int64_t;
+    using V = __m256i;
+    static constexpr size_type width = 4;
+    static constexpr bool has_minmax = true;
+    POOL_SIMD_AVX2 static V load(const T* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const V*>(p)); }
+    POOL_SIMD_AVX2 static void store(T* p, V v) noexcept { _mm256_storeu_si256(reinterpret_cast<V*>(p), v); }
+    POOL_SIMD_AVX2 static V set1(T x) noexcept { return _mm256_set1_epi64x(x); }
+    POOL_SIMD_AVX2 static unsigned eq_mask(V a, V b) noexcept {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)));
+    }
+    POOL_SIMD_AVX2 static V min(V a, V b) noexcept { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+    POOL_SIMD_AVX2 static V max(V a, V b) noexcept { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+    POOL_SIMD_AVX2 static V add(V a, V b) noexcept { return _mm256_add_epi64(a, b); }
+};
+
+template <>
+struct Avx2<float> {
+    using T = float;
+    using V = __m256;
+    static constexpr size_type width = 8;
+    static constexpr bool has_minmax = true;
+    POOL_SIMD_AVX2 static V load(const T* p) noexcept { return _mm256_loadu_ps(p); }
+    POOL_SIMD_AVX2 static void store(T* p, V v) noexcept { _mm256_storeu_ps(p, v); }
+    POOL_SIMD_AVX2 static V set1(T x) noexcept { return _mm256_set1_ps(x); }
+    POOL_SIMD_AVX2 static unsigned eq_mask(V a, V b) noexcept { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    POOL_SIMD_AVX2 static V min(V a, V b) noexcept { return _mm256_min_ps(a, b); }
+    POOL_SIMD_AVX2 static V max(V a, V b) noexcept { return _mm256_max_ps(a, b); }
+    POOL_SIMD_AVX2 static V add(V a, V b) noexcept { return _mm256_add_ps(a, b); }
+};
+
+template <>
+struct Avx2<double> {
+    using T = double;
+    using V = __m256d;
+    static constexpr size_type width = 4;
+    static constexpr bool has_minmax = true;
+    POOL_SIMD_AVX2 static V load(const T* p) noexcept { return _mm256_loadu_pd(p); }
+    POOL_SIMD_AVX2 static void store(T* p, V v) noexcept { _mm256_storeu_pd(p, v); }
+    POOL_SIMD_AVX2 static V set1(T x) noexcept { return _mm256_set1_pd(x); }
+    POOL_SIMD_AVX2 static unsigned eq_mask(V a, V b) noexcept { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+    POOL_SIMD_AVX2 static V min(V a, V b) noexcept { return _mm256_min_pd(a, b); }
+    POOL_SIMD_AVX2 static V max(V a, V b) noexcept { return _mm256_max_pd(a, b); }
+    POOL_SIMD_AVX2 static V add(V a, V b) noexcept { return _mm256_add_pd(a, b); }
+};
+
+// ---- AVX-512F：比较直接得到掩码寄存器 ----
+// min / max 用全 1 掩码的 mask 版本：GCC 12 的非掩码版本内部用未初始化的寄存器作为源，-Wall 下会误报
+
+template <class T>
+struct Avx512;
+
+template <>
+struct Avx512<std::int32_t> {
+    using T = std::int32_t;
+    using V = __m512i;
+    static constexpr size_type width = 16;
+    static constexpr bool has_minmax = true;
+    POOL_SIMD_AVX512 static V load(const T* p) noexcept { return _mm512_loadu_si512(p); }
+    POOL_SIMD_AVX512 static void store(T* p, V v) noexcept { _mm512_storeu_si512(p, v); }
+    POOL_SIMD_AVX512 static V set1(T x) noexcept { return _mm512_set1_epi32(x); }
+    POOL_SIMD_AVX512 static unsigned eq_mask(V a, V b) noexcept { return _mm512_cmpeq_epi32_mask(a, b); }
+    POOL_SIMD_AVX512 static V min(V a, V b) noexcept { return _mm512_mask_min_epi32(a, __mmask16(-1), a, b); }
+    POOL_SIMD_AVX512 static V max(V a, V b) noexcept { return _mm512_mask_max_epi32(a, __mmask16(-1), a, b); }
+    POOL_SIMD_AVX512 static V add(V a, V b) noexcept { return _mm512_add_epi32(a, b); }
+};
+
+template <>
+struct Avx512<std::int64_t> {
+    using T = std::int64_t;
+    using V = __m512i;
+    static constexpr size_type width = 8;
+    static constexpr bool has_minmax = true;
+    POOL_SIMD_AVX512 static V load(const T* p) noexcept { return _mm512_loadu_si512(p); }
+    POOL_SIMD_AVX512 static void store(T* p, V v) noexcept { _mm512_storeu_si512(p, v); }
+    POOL_SIMD_AVX512 static V set1(T x) noexcept { return _mm512_set1_epi64(x); }
+    POOL_SIMD_AVX512 static unsigned eq_mask(V a, V b) noexcept { return _mm512_cmpeq_epi64_mask(a, b); }
+    POOL_SIMD_AVX512 static V min(V a, V b) noexcept { return _mm512_mask_min_epi64(a, __mmask8(-1), a, b); }
+    POOL_SIMD_AVX512 static V max(V a, V b) noexcept { return _mm512_mask_max_epi64(a, __mmask8(-1), a, b); }
+    POOL_SIMD_AVX512 static V add(V a, V b) noexcept { return _mm512_add_epi64(a, b); }
+};
+
+template <>
+struct Avx512<float> {
+    using T = float;
+    using V = __m512;
+    static constexpr size_type width = 16;
+    static constexpr bool has_minmax = true;
+    POOL_SIMD_AVX512 static V load(const T* p) noexcept { return _mm512_loadu_ps(p); }
+    POOL_SIMD_AVX512 static void store(T* p, V v) noexcept { _mm512_storeu_ps(p, v); }
+    POOL_SIMD_AVX512 static V set1(T x) noexcept { return _mm512_set1_ps(x); }
+    POOL_SIMD_AVX512 static unsigned eq_mask(V a, V b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    POOL_SIMD_AVX512 static V min(V a, V b) noexcept { return _mm512_mask_min_ps(a, __mmask16(-1), a, b); }
+    POOL_SIMD_AVX512 static V max(V a, V b) noexcept { return _mm512_mask_max_ps(a, __mmask16(-1), a, b); }
+    POOL_SIMD_AVX512 static V add(V a, V b) noexcept { return _mm512_add_ps(a, b); }
+};
+
+template <>
+struct Avx512<double> {
+    using T = double;
+    using V = __m512d;
+    static constexpr size_type width = 8;
+    static constexpr bool has_minmax = true;
+    POOL_SIMD_AVX512 static V load(const T* p) noexcept { return _mm512_loadu_pd(p); }
+    POOL_SIMD_AVX512 static void store(T* p, V v) noexcept { _mm512_storeu_pd(p, v); }
+    POOL_SIMD_AVX512 static V set1(T x) noexcept { return _mm512_set1_pd(x); }
+    POOL_SIMD_AVX512 static unsigned eq_mask(V a, V b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    POOL_SIMD_AVX512 static V min(V a, V b) noexcept { return _mm512_mask_min_pd(a, __mmask8(-1), a, b); }
+    POOL_SIMD_AVX512 static V max(V a, V b) noexcept { return _mm512_mask_max_pd(a, __mmask8(-1), a, b); }
+    POOL_SIMD_AVX512 static V add(V a, V b) noexcept { return _mm512_add_pd(a, b); }
+};
+
+POOL_SIMD_KERNELS(Sse2, )
+POOL_SIMD_KERNELS(Avx2, POOL_SIMD_AVX2)
+POOL_SIMD_KERNELS(Avx512, POOL_SIMD_AVX512)
+
+inline SimdLevel detect_level() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::avx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::avx2;
+    return SimdLevel::sse2;
+}
+
+#elif defined(POOL_SIMD_NEON)
+
+// ---- NEON：没有 movemask，用每条车道一个位的权重求和拼出掩码 ----
+
+template <class T>
+struct Neon;
+
+template <>
+struct Neon<std::int32_t> {
+    using T = std::int32_t;
+    using V = int32x4_t;
+    static constexpr size_type width = 4;
+    static constexpr bool has_minmax = true;
+    static V load(const T* p) noexcept { return vld1q_s32(p); }
+    static void store(T* p, V v) noexcept { vst1q_s32(p, v); }
+    static V set1(T x) noexcept { return vdupq_n_s32(x); }
+    static unsigned eq_mask(V a, V b) noexcept {
+        static const std::uint32_t bits[4] = {1, 2, 4, 8};
+        return vaddvq_u32(vandq_u32(vceqq_s32(a, b), vld1q_u32(bits)));
+    }
+    static V min(V a, V b) noexcept { return vminq_s32(a, b); }
+    static V max(V a, V b) noexcept { return vmaxq_s32(a, b); }
+    static V add(V a, V b) noexcept { return vaddq_s32(a, b); }
+};
+
+template <>
+struct Neon<std::int64_t> {
+    using T = std::int64_t;
+    using V = int64x2_t;
+    static constexpr size_type width = 2;
+    static constexpr bool has_minmax = true;
+    static V load(const T* p) noexcept { return vld1q_s64(p); }
+    static void store(T* p, V v) noexcept { vst1q_s64(p, v); }
+    static V set1(T x) noexcept { return vdupq_n_s64(x); }
+    static unsigned eq_mask(V a, V b) noexcept {
+        static const std::uint64_t bits[2] = {1, 2};
+        return static_cast<unsigned>(vaddvq_u64(vandq_u64(vceqq_s64(a, b), vld1q_u64(bits))));
+    }
+    static V min(V a, V b) noexcept { return vbslq_s64(vcgtq_s64(a, b), b, a); }
+    static V max(V a, V b) noexcept { return vbslq_s64(vcgtq_s64(a, b), a, b); }
+    static V add(V a, V b) noexcept { return vaddq_s64(a, b); }
+};
+
+template <>
+struct Neon<float> {
+    using T = float;
+    using V = float32x4_t;
+    static constexpr size_type width = 4;
+    static constexpr bool has_minmax = true;
+    static V load(const T* p) noexcept { return vld1q_f32(p); }
+    static void store(T* p, V v) noexcept { vst1q_f32(p, v); }
+    static V set1(T x) noexcept { return vdupq_n_f32(x); }
+    static unsigned eq_mask(V a, V b) noexcept {
+        static const std::uint32_t bits[4] = {1, 2, 4, 8};
+        return vaddvq_u32(vandq_u32(vceqq_f32(a, b), vld1q_u32(bits)));
+    }
+    static V min(V a, V b) noexcept { return vminq_f32(a, b); }
+    static V max(V a, V b) noexcept { return vmaxq_f32(a, b); }
+    static V add(V a, V b) noexcept { return vaddq_f32(a, b); }
+};
+
+template <>
+struct Neon<double> {
+    using T = double;
+    using V = float64x2_t;
+    static constexpr size_type width = 2;
+    static constexpr bool has_minmax = true;
+    static V load(const T* p) noexcept { return vld1q_f64(p); }
+    static void store(T* p, V v) noexcept { vst1q_f64(p, v); }
+    static V set1(T x) noexcept { return vdupq_n_f64(x); }
+    static unsigned eq_mask(V a, V b) noexcept {
+        static const std::uint64_t bits[2] = {1, 2};
+        return static_cast<unsigned>(vaddvq_u64(vandq_u64(vceqq_f64(a, b), vld1q_u64(bits))));
+    }
+    static V min(V a, V b) noexcept { return vminq_f64(a, b); }
+    static V max(V a, V b) noexcept { return vmaxq_f64(a, b); }
+    static V add(V a, V b) noexcept { return vaddq_f64(a, b); }
+};
+
+POOL_SIMD_KERNELS(Neon, )
+
+inline SimdLevel detect_level() noexcept { return SimdLevel::neon; }
+
+#else
+
+inline SimdLevel detect_level() noexcept { return SimdLevel::scalar; }
+
+#endif
+
+#undef POOL_SIMD_KERNELS
+
+inline SimdLevel& active_level() noexcept {
+    static SimdLevel level = detect_level();
+    return level;
+}
+
+// 按当前级别选择实现；min / max 在没有向量比较时（has_minmax 为 false）退回标量
+#if defined(POOL_SIMD_X86)
+#define POOL_SIMD_DISPATCH(OP, SCALAR, ...)                                          \
+    switch (active_level()) {                                                        \
+    case SimdLevel::avx512: return OP##_Avx512(__VA_ARGS__);                         \
+    case SimdLevel::avx2: return OP##_Avx2(__VA_ARGS__);                             \
+    case SimdLevel::sse2: return OP##_Sse2(__VA_ARGS__);                             \
+    default: return SCALAR;                                                          \
+    }
+#elif defined(POOL_SIMD_NEON)
+#define POOL_SIMD_DISPATCH(OP, SCALAR, ...)                                          \
+    if (active_level() == SimdLevel::neon) return OP##_Neon(__VA_ARGS__);        \
+    return SCALAR;
+#else
+#define POOL_SIMD_DISPATCH(OP, SCALAR, ...) return SCALAR;
+#endif
+
+template <class T>
+const T* find(const T* p, const T* e, T x) noexcept {
+    POOL_SIMD_DISPATCH(find, find_scalar(p, e, x), p, e, x)
+}
+
+template <class T>
+size_type count(const T* p, const T* e, T x) noexcept {
+    POOL_SIMD_DISPATCH(count, count_scalar(p, e, x), p, e, x)
+}
+
+template <class T>
+T sum(const T* p, const T* e) noexcept {
+    POOL_SIMD_DISPATCH(sum, sum_scalar(p, e, T(0)), p, e)
+}
+
+template <class T>
+void fill(T* p, T* e, T x) noexcept {
+    POOL_SIMD_DISPATCH(fill, fill_scalar(p, e, x), p, e, x)
+}
+
+#undef POOL_SIMD_DISPATCH
+
+template <class T, bool Min>
+T extreme(const T* p, const T* e) noexcept {
+    SimdLevel level = active_level();
+#if defined(POOL_SIMD_X86)
+    if (level == SimdLevel::avx512) return extreme_Avx512<T, Min>(p, e);
+    if (level == SimdLevel::avx2) return extreme_Avx2<T, Min>(p, e);
+    if (level == SimdLevel::sse2 && Sse2<T>::has_minmax) return extreme_Sse2<T, Min>(p, e);
+#elif defined(POOL_SIMD_NEON)
+    if (level == SimdLevel::neon) return extreme_Neon<T, Min>(p, e);
+#endif
+    (void)level;
+    return Min ? min_scalar(p + 1, e, *p) : max_scalar(p + 1, e, *p);
+}
+
+} // namespace simd_detail
+
+inline SimdLevel simd_level() noexcept { return simd_detail::active_level(); }
+
+// 只能降到本机支持的级别以下（scalar 总是可用）；返回实际生效的级别
+inline SimdLevel set_simd_level(SimdLevel level) noexcept {
+    SimdLevel best = simd_detail::detect_level();
+    bool ok = level == SimdLevel::scalar || level == best;
+#if defined(POOL_SIMD_X86)
+    ok = ok || (level == SimdLevel::sse2) || (level == SimdLevel::avx2 && best == SimdLevel::avx512);
+#endif
+    simd_detail::active_level() = ok ? level : best;
+    return simd_detail::active_level();
+}
+
+// 返回第一个等于 x 的元素，找不到返回 last
+template <class T>
+const T* simd_find(const T* first, const T* last, T x) noexcept {
+    if constexpr (simd_detail::is_vector_type<T>::value) return simd_detail::find(first, last, x);
+    else return simd_detail::find_scalar(first, last, x);
+}
+
+template <class T>
+T* simd_find(T* first, T* last, T x) noexcept {
+    return const_cast<T*>(simd_find(static_cast<const T*>(first), static_cast<const T*>(last), x));
+}
+
+template <class T>
+std::size_t simd_count(const T* first, const T* last, T x) noexcept {
+    if constexpr (simd_detail::is_vector_type<T>::value) return simd_detail::count(first, last, x);
+    else return simd_detail::count_scalar(first, last, x);
+}
+
+template <class T>
+T simd_min(const T* first, const T* last) noexcept {
+    if constexpr (simd_detail::is_vector_type<T>::value) return simd_detail::extreme<T, true>(first, last);
+    else return simd_detail::min_scalar(first + 1, last, *first);
+}
+
+template <class T>
+T simd_max(const T* first, const T* last) noexcept {
+    if constexpr (simd_detail::is_vector_type<T>::value) return simd_detail::extreme<T, false>(first, last);
+    else return simd_detail::max_scalar(first + 1, last, *first);
+}
+
+template <class T>
+T simd_sum(const T* first, const T* last) noexcept {
+    if constexpr (simd_detail::is_vector_type<T>::value) return simd_detail::sum(first, last);
+    else return simd_detail::sum_scalar(first, last, T(0));
+}
+
+template <class T>
+void simd_fill(T* first, T* last, T x) noexcept {
+    if constexpr (simd_detail::is_vector_type<T>::value) simd_detail::fill(first, last, x);
+    else simd_detail::fill_scalar(first, last, x);
+}
+
+template <class T, class A, class G>
+std::size_t simd_find_index(const SimpleSeq<T, A, G>& s, T x) noexcept {
+    return static_cast<std::size_t>(simd_find(s.data(), s.data() + s.size(), x) - s.data());
+}
+
+template <class T, class A, class G>
+std::size_t simd_count(const SimpleSeq<T, A, G>& s, T x) noexcept {
+    return simd_count(s.data(), s.data() + s.size(), x);
+}
+
+template <class T, class A, class G>
+T simd_min(const SimpleSeq<T, A, G>& s) noexcept {
+    return simd_min(s.data(), s.data() + s.size());
+}
+
+template <class T, class A, class G>
+T simd_max(const SimpleSeq<T, A, G>& s) noexcept {
+    return simd_max(s.data(), s.data() + s.size());
+}
+
+template <class T, class A, class G>
+T simd_sum(const SimpleSeq<T, A, G>& s) noexcept {
+    return simd_sum(s.data(), s.data() + s.size());
+}
+
+template <class T, class A, class G>
+void simd_fill(SimpleSeq<T, A, G>& s, T x) noexcept {
+    simd_fill(s.data(), s.data() + s.size(), x);
+}
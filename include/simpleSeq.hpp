@@ -2,14 +2,83 @@
 #include <memory>
 #include <cstddef>
 #include <iterator>
+#include <utility>
+#include <type_traits>
+#include <cstring>
+#include <algorithm>
+#include <new>
+#include <stdexcept>
 
 // 一个非常精简的顺序容器，支持分配器模板参数。
-// - push_back
+// - push_back / emplace_back（支持右值，避免重复拷贝）
+// - 拷贝/移动构造与赋值（遵守 allocator_traits 的 propagate_on_container_* 约定）
 // - begin/end (指针迭代器)
-// - size, empty
+// - size, empty, capacity, shrink_to_fit
+// - 批量操作：区间构造、assign、insert(pos, first, last)、append_range、
+//   resize(n) / resize(n, v) / resize_for_overwrite(n)；
+//   前向迭代器输入先算长度、只分配一次，可平凡拷贝的连续输入直接 memcpy
 // 设计用于测试自定义分配器与 std::allocator 的可用性。
+//
+// 第三个模板参数是增长策略，决定满了之后的新容量（以及第一次分配的最小容量）：
+// - DoublingGrowth<Min>：翻倍（默认，Min = 2，与原来的行为一致）；
+// - HalfGrowth<Min>：1.5 倍，释放的旧块加起来更早能容纳新块，便于分配器复用；
+// - PoolSizeClassGrowth<Min>（poolAllocator.hpp）：翻倍后向上取整到 PoolAllocator 大块的级别，
+//   不浪费级别内剩余的空间。
+// 策略只需提供 static size_t next_capacity(size_t capacity, size_t required, size_t elem_size)。
+//
+// 扩容时的元素搬迁按编译期类型分派：
+// - is_trivially_relocatable<T> 为真（默认即可平凡拷贝的类型）时一次 memcpy；
+//   用户类型如果“按字节搬走、不调用析构”是安全的，可以特化这个 trait 选择加入；
+// - 分配器提供 try_expand(p, old_n, new_n)（如 PoolAllocator）时先尝试原地扩容，完全不用搬。
 
-template <typename T, typename Alloc = std::allocator<T>>
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+namespace seq_detail {
+
+template <class A, class = void>
+struct has_try_expand : std::false_type {};
+
+template <class A>
+struct has_try_expand<A, std::void_t<decltype(std::declval<A&>().try_expand(
+    std::declval<typename std::allocator_traits<A>::pointer>(),
+    std::declval<typename std::allocator_traits<A>::size_type>(),
+    std::declval<typename std::allocator_traits<A>::size_type>()))>> : std::true_type {};
+
+template <class It, class = void>
+struct is_iterator : std::false_type {};
+
+template <class It>
+struct is_iterator<It, std::void_t<typename std::iterator_traits<It>::iterator_category>> : std::true_type {};
+
+template <class It>
+constexpr bool is_forward_iterator = std::is_base_of<
+    std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value;
+
+// 指向同类型、可平凡拷贝元素的指针：可以整段 memcpy
+template <class It, class T>
+constexpr bool is_memcpy_source =
+    std::is_pointer<It>::value &&
+    std::is_same<std::remove_cv_t<std::remove_pointer_t<It>>, T>::value &&
+    std::is_trivially_copyable<T>::value;
+
+} // namespace seq_detail
+
+template <std::size_t MinCapacity = 2>
+struct DoublingGrowth {
+    static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t) noexcept {
+        return std::max({capacity * 2, required, MinCapacity});
+    }
+};
+
+template <std::size_t MinCapacity = 4>
+struct HalfGrowth {
+    static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t) noexcept {
+        return std::max({capacity + capacity / 2, required, MinCapacity});
+    }
+};
+
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = DoublingGrowth<>>
 class SimpleSeq {
 public:
     using value_type = T;
@@ -27,24 +96,170 @@ public:
         }
     }
 
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    SimpleSeq(It first, It last, const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        guarded([&] { assign(first, last); });
+    }
+
+    SimpleSeq(const SimpleSeq& other)
+        : alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_)) {
+        guarded([&] { copy_from(other); });
+    }
+
+    SimpleSeq(const SimpleSeq& other, const Alloc& alloc) : alloc_(alloc) {
+        guarded([&] { copy_from(other); });
+    }
+
+    SimpleSeq(SimpleSeq&& other) noexcept : alloc_(std::move(other.alloc_)) {
+        steal(other);
+    }
+
+    SimpleSeq(SimpleSeq&& other, const Alloc& alloc) : alloc_(alloc) {
+        if (alloc_ == other.alloc_) {
+            steal(other);
+        } else {
+            guarded([&] { move_elements_from(other); });
+        }
+    }
+
     ~SimpleSeq() {
+        release();
+    }
+
+    SimpleSeq& operator=(const SimpleSeq& other) {
+        if (this == &other) return *this;
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) release();
+            alloc_ = other.alloc_;
+        }
         clear();
-        if (data_) {
-            alloc_traits::deallocate(alloc_, data_, capacity_);
+        copy_from(other);
+        return *this;
+    }
+
+    SimpleSeq& operator=(SimpleSeq&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value) {
+        if (this == &other) return *this;
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+            release();
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                release();
+                steal(other);
+            } else {
+                // 分配器不相等又不能传播：只能逐个移动元素
+                clear();
+                move_elements_from(other);
+            }
         }
+        return *this;
     }
 
+    void swap(SimpleSeq& other) noexcept {
+        using std::swap;
+        if constexpr (alloc_traits::propagate_on_container_swap::value) swap(alloc_, other.alloc_);
+        swap(data_, other.data_);
+        swap(size_, other.size_);
+        swap(capacity_, other.capacity_);
+    }
+
+    friend void swap(SimpleSeq& a, SimpleSeq& b) noexcept { a.swap(b); }
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
     void push_back(const T& v) {
+        emplace_back(v);
+    }
+
+    void push_back(T&& v) {
+        emplace_back(std::move(v));
+    }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
         if (size_ >= capacity_) {
-            grow();
+            return emplace_back_grow(std::forward<Args>(args)...);
+        }
+        alloc_traits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+        return data_[size_++];
+    }
+
+    void pop_back() {
+        alloc_traits::destroy(alloc_, data_ + --size_);
+    }
+
+    // 用 [first, last) 替换全部内容；前向迭代器只分配一次且容量恰好够用
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    void assign(It first, It last) {
+        clear();
+        if constexpr (seq_detail::is_forward_iterator<It>) {
+            size_type n = static_cast<size_type>(std::distance(first, last));
+            if (n > capacity_) {
+                release();
+                reserve(n);
+            }
+            construct_range(data_, first, n);
+            size_ = n;
+        } else {
+            for (; first != last; ++first) emplace_back(*first);
+        }
+    }
+
+    template <class It, class = std::enable_if_t<seq_detail::is_iterator<It>::value>>
+    iterator insert(const_iterator pos, It first, It last) {
+        size_type offset = static_cast<size_type>(pos - data_);
+        size_type old_size = size_;
+        append(first, last);
+        std::rotate(data_ + offset, data_ + old_size, data_ + size_);
+        return data_ + offset;
+    }
+
+    template <class Range>
+    void append_range(Range&& r) {
+        using std::begin;
+        using std::end;
+        append(begin(r), end(r));
+    }
+
+    void resize(size_type n) {
+        if (n <= size_) {
+            destroy_tail(n);
+            return;
+        }
+        append_n(n - size_, [&](pointer p) { alloc_traits::construct(alloc_, p); });
+    }
+
+    void resize(size_type n, const T& v) {
+        if (n <= size_) {
+            destroy_tail(n);
+            return;
         }
-        alloc_traits::construct(alloc_, data_ + size_, v);
-        ++size_;
+        append_n(n - size_, [&](pointer p) { alloc_traits::construct(alloc_, p, v); });
+    }
+
+    // 新元素只做默认初始化（int 等平凡类型不清零），适合紧接着整段覆盖写入
+    void resize_for_overwrite(size_type n) {
+        if (n <= size_) {
+            destroy_tail(n);
+            return;
+        }
+        append_n(n - size_, [](pointer p) { ::new (static_cast<void*>(p)) T; });
     }
 
     size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    size_type max_size() const noexcept { return alloc_traits::max_size(alloc_); }
     bool empty() const noexcept { return size_ == 0; }
 
+    T& operator[](size_type i) noexcept { return data_[i]; }
+    const T& operator[](size_type i) const noexcept { return data_[i]; }
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
     iterator begin() noexcept { return data_; }
     iterator end() noexcept { return data_ + size_; }
     const_iterator begin() const noexcept { return data_; }
@@ -52,16 +267,38 @@ public:
 
     void reserve(size_type new_cap) {
         if (new_cap <= capacity_) return;
+        if (try_expand_in_place(new_cap)) return;
         pointer new_data = alloc_traits::allocate(alloc_, new_cap);
-        for (size_type i = 0; i < size_; ++i) {
-            alloc_traits::construct(alloc_, new_data + i, std::move_if_noexcept(data_[i]));
-            alloc_traits::destroy(alloc_, data_ + i);
+        try {
+            relocate_to(new_data);
+        } catch (...) {
+            alloc_traits::deallocate(alloc_, new_data, new_cap);
+            throw;
         }
         if (data_) alloc_traits::deallocate(alloc_, data_, capacity_);
         data_ = new_data;
         capacity_ = new_cap;
     }
 
+    // 把容量收缩到 size()；空序列直接归还缓冲区
+    void shrink_to_fit() {
+        if (size_ == capacity_) return;
+        if (size_ == 0) {
+            release();
+            return;
+        }
+        pointer new_data = alloc_traits::allocate(alloc_, size_);
+        try {
+            relocate_to(new_data);
+        } catch (...) {
+            alloc_traits::deallocate(alloc_, new_data, size_);
+            throw;
+        }
+        alloc_traits::deallocate(alloc_, data_, capacity_);
+        data_ = new_data;
+        capacity_ = size_;
+    }
+
     void clear() {
         for (size_type i = 0; i < size_; ++i)
             alloc_traits::destroy(alloc_, data_ + i);
@@ -75,8 +312,189 @@ private:
     size_type size_ = 0;
     size_type capacity_ = 0;
 
+    size_type next_capacity() const noexcept {
+        return Growth::next_capacity(capacity_, size_ + 1, sizeof(T));
+    }
+
     void grow() {
-        size_type newcap = capacity_ == 0 ? 2 : capacity_ * 2;
-        reserve(newcap);
+        reserve(next_capacity());
+    }
+
+    // 先在新缓冲区里构造新元素，再搬旧元素：args 可能引用本容器里的元素
+    template <class... Args>
+    T& emplace_back_grow(Args&&... args) {
+        size_type new_cap = next_capacity();
+        if (try_expand_in_place(new_cap)) {
+            alloc_traits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+            return data_[size_++];
+        }
+        pointer new_data = alloc_traits::allocate(alloc_, new_cap);
+        try {
+            alloc_traits::construct(alloc_, new_data + size_, std::forward<Args>(args)...);
+        } catch (...) {
+            alloc_traits::deallocate(alloc_, new_data, new_cap);
+            throw;
+        }
+        try {
+            relocate_to(new_data);
+        } catch (...) {
+            alloc_traits::destroy(alloc_, new_data + size_);
+            alloc_traits::deallocate(alloc_, new_data, new_cap);
+            throw;
+        }
+        if (data_) alloc_traits::deallocate(alloc_, data_, capacity_);
+        data_ = new_data;
+        capacity_ = new_cap;
+        return data_[size_++];
+    }
+
+    // 构造函数里用：填充失败时析构函数不会运行，要自己释放
+    template <class F>
+    void guarded(F&& fill) {
+        try {
+            fill();
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    template <class It>
+    void append(It first, It last) {
+        if constexpr (seq_detail::is_forward_iterator<It>) {
+            size_type n = static_cast<size_type>(std::distance(first, last));
+            append_block(n, [&](pointer dst) { construct_range(dst, first, n); });
+        } else {
+            for (; first != last; ++first) emplace_back(*first);
+        }
+    }
+
+    // 在 dst 上构造 [first, first + n)；抛异常时销毁已构造的部分
+    template <class It>
+    void construct_range(pointer dst, It first, size_type n) {
+        if constexpr (seq_detail::is_memcpy_source<It, T>) {
+            if (n) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(first), n * sizeof(T));
+        } else {
+            size_type i = 0;
+            try {
+                for (; i < n; ++i, ++first) alloc_traits::construct(alloc_, dst + i, *first);
+            } catch (...) {
+                while (i-- > 0) alloc_traits::destroy(alloc_, dst + i);
+                throw;
+            }
+        }
+    }
+
+    // 逐个用 make(p) 在末尾构造 n 个元素
+    template <class F>
+    void append_n(size_type n, F&& make) {
+        append_block(n, [&](pointer dst) {
+            size_type i = 0;
+            try {
+                for (; i < n; ++i) make(dst + i);
+            } catch (...) {
+                while (i-- > 0) alloc_traits::destroy(alloc_, dst + i);
+                throw;
+            }
+        });
+    }
+
+    // 在末尾追加 n 个由 fill(dst) 一次构造好的元素，最多分配一次。
+    // 需要换缓冲区时先在新缓冲区里构造新元素再搬旧元素，输入可以引用本容器里的元素。
+    template <class F>
+    void append_block(size_type n, F&& fill) {
+        if (n == 0) return;
+        if (n > max_size() - size_) throw std::length_error("SimpleSeq: size exceeds max_size()");
+        size_type required = size_ + n;
+        if (required > capacity_) {
+            size_type new_cap = std::max(Growth::next_capacity(capacity_, required, sizeof(T)), required);
+            if (!try_expand_in_place(new_cap)) {
+                pointer new_data = alloc_traits::allocate(alloc_, new_cap);
+                try {
+                    fill(new_data + size_);
+                } catch (...) {
+                    alloc_traits::deallocate(alloc_, new_data, new_cap);
+                    throw;
+                }
+                try {
+                    relocate_to(new_data);
+                } catch (...) {
+                    for (size_type i = 0; i < n; ++i) alloc_traits::destroy(alloc_, new_data + size_ + i);
+                    alloc_traits::deallocate(alloc_, new_data, new_cap);
+                    throw;
+                }
+                if (data_) alloc_traits::deallocate(alloc_, data_, capacity_);
+                data_ = new_data;
+                capacity_ = new_cap;
+                size_ = required;
+                return;
+            }
+        }
+        fill(data_ + size_);
+        size_ = required;
+    }
+
+    void destroy_tail(size_type n) noexcept {
+        for (size_type i = n; i < size_; ++i) alloc_traits::destroy(alloc_, data_ + i);
+        size_ = n;
+    }
+
+    bool try_expand_in_place(size_type new_cap) {
+        if constexpr (seq_detail::has_try_expand<Alloc>::value) {
+            if (data_ && alloc_.try_expand(data_, capacity_, new_cap)) {
+                capacity_ = new_cap;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 把 [0, size_) 搬到 new_data，旧元素随后失效（两块缓冲区都由调用方管理）。
+    // 逐个搬迁时拷贝构造可能抛异常：这时销毁已构造的新元素再抛出，旧内容不变。
+    void relocate_to(pointer new_data) {
+        if constexpr (is_trivially_relocatable<T>::value) {
+            if (size_) std::memcpy(static_cast<void*>(new_data), static_cast<const void*>(data_), size_ * sizeof(T));
+        } else {
+            size_type i = 0;
+            try {
+                for (; i < size_; ++i)
+                    alloc_traits::construct(alloc_, new_data + i, std::move_if_noexcept(data_[i]));
+            } catch (...) {
+                while (i-- > 0) alloc_traits::destroy(alloc_, new_data + i);
+                throw;
+            }
+            for (i = 0; i < size_; ++i) alloc_traits::destroy(alloc_, data_ + i);
+        }
+    }
+
+    void release() noexcept {
+        clear();
+        if (data_) alloc_traits::deallocate(alloc_, data_, capacity_);
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+
+    void steal(SimpleSeq& other) noexcept {
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.data_ = nullptr;
+        other.size_ = other.capacity_ = 0;
+    }
+
+    void copy_from(const SimpleSeq& other) {
+        reserve(other.size_);
+        for (size_type i = 0; i < other.size_; ++i) {
+            alloc_traits::construct(alloc_, data_ + i, other.data_[i]);
+            ++size_;
+        }
+    }
+
+    void move_elements_from(SimpleSeq& other) {
+        reserve(other.size_);
+        for (size_type i = 0; i < other.size_; ++i) {
+            alloc_traits::construct(alloc_, data_ + i, std::move(other.data_[i]));
+            ++size_;
+        }
     }
 };
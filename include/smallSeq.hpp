@@ -0,0 +1,259 @@
+#pragma once
+#include <memory>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include "simpleSeq.hpp"
+
+// 带内联存储（small-buffer optimization）的 SimpleSeq 兄弟版本。
+// 前 InlineN 个元素直接放在对象里，只有超过 InlineN 时才调用 alloc_traits::allocate；
+// 大多数只装几个元素、很快就销毁的序列因此完全不分配内存。
+// 接口与 SimpleSeq 一致（push_back / emplace_back / reserve / shrink_to_fit / 拷贝移动 ...），
+// 增长策略和 is_trivially_relocatable 也沿用 SimpleSeq 的。
+// 注意：移动内联存储的序列时元素是逐个移动的，被移动的序列之后为空。
+
+template <typename T, std::size_t InlineN, typename Alloc = std::allocator<T>,
+          typename Growth = DoublingGrowth<InlineN * 2>>
+class SmallSeq {
+    static_assert(InlineN > 0, "SmallSeq needs at least one inline element; use SimpleSeq otherwise");
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_type inline_capacity = InlineN;
+
+    // 默认构造就地构造分配器，不拷贝临时对象；默认构造不分配的分配器（如 PoolAllocator）因此一点内存都不占
+    SmallSeq() noexcept(std::is_nothrow_default_constructible<Alloc>::value) : alloc_() {}
+
+    explicit SmallSeq(const Alloc& alloc) noexcept(std::is_nothrow_copy_constructible<Alloc>::value)
+        : alloc_(alloc) {}
+
+    SmallSeq(const SmallSeq& other)
+        : alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_)) {
+        guarded([&] { copy_from(other); });
+    }
+
+    SmallSeq(SmallSeq&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : alloc_(std::move(other.alloc_)) {
+        take(other);
+    }
+
+    ~SmallSeq() {
+        release();
+    }
+
+    SmallSeq& operator=(const SmallSeq& other) {
+        if (this == &other) return *this;
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) release();
+            alloc_ = other.alloc_;
+        }
+        clear();
+        copy_from(other);
+        return *this;
+    }
+
+    SmallSeq& operator=(SmallSeq&& other) {
+        if (this == &other) return *this;
+        release();
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+            alloc_ = other.alloc_;
+        }
+        take(other);
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    void push_back(const T& v) {
+        emplace_back(v);
+    }
+
+    void push_back(T&& v) {
+        emplace_back(std::move(v));
+    }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ >= capacity_) {
+            return emplace_back_grow(std::forward<Args>(args)...);
+        }
+        alloc_traits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+        return data_[size_++];
+    }
+
+    void pop_back() {
+        alloc_traits::destroy(alloc_, data_ + --size_);
+    }
+
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+    // 元素是否还在对象内部（没有堆/池上的缓冲区）
+    bool is_inline() const noexcept { return data_ == inline_data(); }
+
+    T& operator[](size_type i) noexcept { return data_[i]; }
+    const T& operator[](size_type i) const noexcept { return data_[i]; }
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    void reserve(size_type new_cap) {
+        if (new_cap <= capacity_) return;
+        pointer new_data = alloc_traits::allocate(alloc_, new_cap);
+        adopt(new_data, new_cap);
+    }
+
+    // 放得进内联存储就搬回去，否则收缩到 size()
+    void shrink_to_fit() {
+        if (is_inline() || size_ == capacity_) return;
+        pointer old = data_;
+        size_type old_cap = capacity_;
+        if (size_ <= InlineN) {
+            relocate(old, inline_data(), size_);
+            data_ = inline_data();
+            capacity_ = InlineN;
+        } else {
+            pointer new_data = alloc_traits::allocate(alloc_, size_);
+            try {
+                relocate(old, new_data, size_);
+            } catch (...) {
+                alloc_traits::deallocate(alloc_, new_data, size_);
+                throw;
+            }
+            data_ = new_data;
+            capacity_ = size_;
+        }
+        alloc_traits::deallocate(alloc_, old, old_cap);
+    }
+
+    void clear() {
+        for (size_type i = 0; i < size_; ++i)
+            alloc_traits::destroy(alloc_, data_ + i);
+        size_ = 0;
+    }
+
+private:
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+    Alloc alloc_;
+    alignas(T) unsigned char inline_[InlineN * sizeof(T)];
+    T* data_ = inline_data();
+    size_type size_ = 0;
+    size_type capacity_ = InlineN;
+
+    T* inline_data() noexcept { return reinterpret_cast<T*>(inline_); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(inline_); }
+
+    size_type next_capacity() const noexcept {
+        return Growth::next_capacity(capacity_, size_ + 1, sizeof(T));
+    }
+
+    // 把 [0, n) 从 from 搬到 to；拷贝构造抛异常时销毁已构造的新元素再抛出，旧内容不变
+    void relocate(pointer from, pointer to, size_type n) {
+        if constexpr (is_trivially_relocatable<T>::value) {
+            if (n) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+        } else {
+            size_type i = 0;
+            try {
+                for (; i < n; ++i)
+                    alloc_traits::construct(alloc_, to + i, std::move_if_noexcept(from[i]));
+            } catch (...) {
+                while (i-- > 0) alloc_traits::destroy(alloc_, to + i);
+                throw;
+            }
+            for (i = 0; i < n; ++i) alloc_traits::destroy(alloc_, from + i);
+        }
+    }
+
+    // 把元素搬进新缓冲区并换上它；失败时归还新缓冲区
+    void adopt(pointer new_data, size_type new_cap) {
+        try {
+            relocate(data_, new_data, size_);
+        } catch (...) {
+            alloc_traits::deallocate(alloc_, new_data, new_cap);
+            throw;
+        }
+        if (!is_inline()) alloc_traits::deallocate(alloc_, data_, capacity_);
+        data_ = new_data;
+        capacity_ = new_cap;
+    }
+
+    template <class... Args>
+    T& emplace_back_grow(Args&&... args) {
+        size_type new_cap = next_capacity();
+        pointer new_data = alloc_traits::allocate(alloc_, new_cap);
+        try {
+            alloc_traits::construct(alloc_, new_data + size_, std::forward<Args>(args)...);
+        } catch (...) {
+            alloc_traits::deallocate(alloc_, new_data, new_cap);
+            throw;
+        }
+        try {
+            relocate(data_, new_data, size_);
+        } catch (...) {
+            alloc_traits::destroy(alloc_, new_data + size_);
+            alloc_traits::deallocate(alloc_, new_data, new_cap);
+            throw;
+        }
+        if (!is_inline()) alloc_traits::deallocate(alloc_, data_, capacity_);
+        data_ = new_data;
+        capacity_ = new_cap;
+        return data_[size_++];
+    }
+
+    template <class F>
+    void guarded(F&& fill) {
+        try {
+            fill();
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    void release() noexcept {
+        clear();
+        if (!is_inline()) alloc_traits::deallocate(alloc_, data_, capacity_);
+        data_ = inline_data();
+        capacity_ = InlineN;
+    }
+
+    void copy_from(const SmallSeq& other) {
+        reserve(other.size_);
+        for (size_type i = 0; i < other.size_; ++i) {
+            alloc_traits::construct(alloc_, data_ + i, other.data_[i]);
+            ++size_;
+        }
+    }
+
+    // 对方在堆上且分配器相等时直接接管缓冲区，否则逐个移动；之后对方为空
+    void take(SmallSeq& other) {
+        if (!other.is_inline() && alloc_ == other.alloc_) {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.size_ = 0;
+            other.capacity_ = InlineN;
+            return;
+        }
+        reserve(other.size_);
+        for (size_type i = 0; i < other.size_; ++i) {
+            alloc_traits::construct(alloc_, data_ + i, std::move(other.data_[i]));
+            ++size_;
+        }
+        other.release();
+    }
+};
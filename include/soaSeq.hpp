@@ -0,0 +1,390 @@
+#pragma once
+#include <memory>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <tuple>
+#include <type_traits>
+#include <algorithm>
+#include "simpleSeq.hpp"
+
+// 列式（structure-of-arrays）顺序容器：SoASeq<float, int, char> 的每个字段单独存成一列，
+// 只扫描一个字段的循环只读这一列，缓存带宽不浪费在其他字段上。
+// - 所有列放在同一次分配的内存里，每列起点按 64 字节（缓存行）对齐；
+//   内存按缓存行为单位通过 rebind 后的分配器申请，PoolAllocator 走 64 字节对齐的大块缓存；
+// - column<I>() 返回第 I 列的 ColumnSpan（指针 + 长度），
+//   `for (float x : s.column<0>())` 这样的循环编译器可以直接向量化；
+// - 增长策略、is_trivially_relocatable 与 SimpleSeq 相同，扩容时每列各搬一次。
+// 分配器和增长策略通过 BasicSoASeq<Alloc, Growth, Fields...> 指定。
+
+namespace seq_detail {
+
+struct alignas(64) CacheLine {
+    unsigned char bytes[64];
+};
+
+} // namespace seq_detail
+
+// 一列元素的只读视图（C++17 没有 std::span）
+template <class T>
+class ColumnSpan {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using iterator = T*;
+
+    constexpr ColumnSpan() noexcept = default;
+    constexpr ColumnSpan(T* data, size_type size) noexcept : data_(data), size_(size) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T& operator[](size_type i) const noexcept { return data_[i]; }
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+
+private:
+    T* data_ = nullptr;
+    size_type size_ = 0;
+};
+
+template <typename Alloc, typename Growth, typename... Fields>
+class BasicSoASeq {
+    static_assert(sizeof...(Fields) > 0, "SoASeq needs at least one field");
+    static_assert(std::max({alignof(Fields)...}) <= 64, "SoASeq columns are only cache-line aligned");
+
+    using Line = seq_detail::CacheLine;
+    using line_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Line>;
+    using alloc_traits = std::allocator_traits<line_alloc>;
+    using indices = std::index_sequence_for<Fields...>;
+
+public:
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+
+    template <std::size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    static constexpr size_type column_count = sizeof...(Fields);
+    static constexpr size_type column_align = sizeof(Line);
+
+    explicit BasicSoASeq(size_type reserve_capacity = 0, const Alloc& alloc = Alloc())
+        : alloc_(alloc) {
+        if (reserve_capacity > 0) {
+            reserve(reserve_capacity);
+        }
+    }
+
+    BasicSoASeq(const BasicSoASeq& other)
+        : alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_)) {
+        guarded([&] { copy_from(other); });
+    }
+
+    BasicSoASeq(BasicSoASeq&& other) noexcept : alloc_(std::move(other.alloc_)) {
+        steal(other);
+    }
+
+    ~BasicSoASeq() {
+        release();
+    }
+
+    BasicSoASeq& operator=(const BasicSoASeq& other) {
+        if (this == &other) return *this;
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) release();
+            alloc_ = other.alloc_;
+        }
+        clear();
+        copy_from(other);
+        return *this;
+    }
+
+    BasicSoASeq& operator=(BasicSoASeq&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value) {
+        if (this == &other) return *this;
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+            release();
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                release();
+                steal(other);
+            } else {
+                // 分配器不相等又不能传播：只能逐行移动
+                clear();
+                reserve(other.size_);
+                for (size_type i = 0; i < other.size_; ++i) move_row(indices{}, other, i);
+                other.release();
+            }
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(alloc_); }
+
+    // 追加一行，每个实参构造对应的一列
+    template <class... Args>
+    void push_back(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "push_back takes one value per field");
+        if (size_ == capacity_) {
+            // 先在新内存里构造新行再搬旧行，实参可以引用本容器里的元素
+            regrow(next_capacity(size_ + 1), 1, [&](pointers& cols) {
+                construct_row(indices{}, cols, size_, std::forward<Args>(args)...);
+            });
+        } else {
+            construct_row(indices{}, columns_, size_, std::forward<Args>(args)...);
+        }
+        ++size_;
+    }
+
+    void pop_back() {
+        --size_;
+        destroy_rows(indices{}, columns_, size_, size_ + 1);
+    }
+
+    // 变长时新行做值初始化
+    void resize(size_type n) {
+        if (n <= size_) {
+            destroy_rows(indices{}, columns_, n, size_);
+            size_ = n;
+            return;
+        }
+        reserve(std::max(n, next_capacity(n)));
+        while (size_ < n) {
+            construct_row(indices{}, columns_, size_, Fields()...);
+            ++size_;
+        }
+    }
+
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    template <std::size_t I>
+    field_type<I>* data() noexcept { return std::get<I>(columns_); }
+    template <std::size_t I>
+    const field_type<I>* data() const noexcept { return std::get<I>(columns_); }
+
+    template <std::size_t I>
+    ColumnSpan<field_type<I>> column() noexcept { return {std::get<I>(columns_), size_}; }
+    template <std::size_t I>
+    ColumnSpan<const field_type<I>> column() const noexcept { return {std::get<I>(columns_), size_}; }
+
+    template <std::size_t I>
+    field_type<I>& get(size_type row) noexcept { return std::get<I>(columns_)[row]; }
+    template <std::size_t I>
+    const field_type<I>& get(size_type row) const noexcept { return std::get<I>(columns_)[row]; }
+
+    void reserve(size_type new_cap) {
+        if (new_cap <= capacity_) return;
+        regrow(new_cap, 0, [](pointers&) {});
+    }
+
+    void shrink_to_fit() {
+        if (size_ == capacity_) return;
+        if (size_ == 0) {
+            release();
+            return;
+        }
+        regrow(size_, 0, [](pointers&) {});
+    }
+
+    void clear() noexcept {
+        destroy_rows(indices{}, columns_, 0, size_);
+        size_ = 0;
+    }
+
+private:
+    using pointers = std::tuple<Fields*...>;
+
+    // 每一行的字节数，传给增长策略当作元素大小
+    static constexpr size_type row_bytes = (sizeof(Fields) + ...);
+
+    line_alloc alloc_;
+    Line* block_ = nullptr;
+    size_type block_lines_ = 0;
+    pointers columns_{};
+    size_type size_ = 0;
+    size_type capacity_ = 0;
+
+    size_type next_capacity(size_type required) const noexcept {
+        return Growth::next_capacity(capacity_, required, row_bytes);
+    }
+
+    static size_type column_lines(size_type cap, size_type elem_size) noexcept {
+        return (cap * elem_size + sizeof(Line) - 1) / sizeof(Line);
+    }
+
+    static size_type lines_for(size_type cap) noexcept {
+        return (column_lines(cap, sizeof(Fields)) + ...);
+    }
+
+    // 把 block 按容量 cap 切成各列，每列从缓存行边界开始
+    template <std::size_t... I>
+    static pointers carve(std::index_sequence<I...>, Line* block, size_type cap) noexcept {
+        pointers cols;
+        Line* at = block;
+        ((std::get<I>(cols) = reinterpret_cast<field_type<I>*>(at), at += column_lines(cap, sizeof(field_type<I>))), ...);
+        return cols;
+    }
+
+    template <std::size_t... I, class... Args>
+    void construct_row(std::index_sequence<I...>, pointers& cols, size_type row, Args&&... args) {
+        std::size_t built = 0;
+        try {
+            ((alloc_traits::construct(alloc_, std::get<I>(cols) + row, std::forward<Args>(args)), ++built), ...);
+        } catch (...) {
+            ((I < built ? alloc_traits::destroy(alloc_, std::get<I>(cols) + row) : void()), ...);
+            throw;
+        }
+    }
+
+    template <std::size_t... I>
+    void destroy_rows(std::index_sequence<I...>, pointers& cols, size_type first, size_type last) noexcept {
+        (destroy_column(std::get<I>(cols), first, last), ...);
+    }
+
+    template <class F>
+    void destroy_column(F* col, size_type first, size_type last) noexcept {
+        if constexpr (!std::is_trivially_destructible<F>::value) {
+            for (size_type i = first; i < last; ++i) alloc_traits::destroy(alloc_, col + i);
+        }
+    }
+
+    // 每列都能不抛异常地搬过去（逐字节复制或 noexcept 移动）时才移动旧行；
+    // 否则除逐字节复制的列以外一律拷贝，某一列失败时所有旧列原封不动。
+    // 既不能 noexcept 移动又不能拷贝的列只能移动，失败时这一列的旧值已被移走（与 std::vector 相同）
+    static constexpr bool nothrow_relocate =
+        ((is_trivially_relocatable<Fields>::value || std::is_nothrow_move_constructible<Fields>::value) && ...);
+
+    template <class F>
+    using relocation_source_t =
+        std::conditional_t<nothrow_relocate || !std::is_copy_constructible<F>::value, F&&, const F&>;
+
+    // 把一列的 [0, size_) 搬到 to；抛异常时销毁已构造的部分
+    template <class F>
+    void relocate_column(F* from, F* to) {
+        if constexpr (is_trivially_relocatable<F>::value) {
+            if (size_) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), size_ * sizeof(F));
+        } else {
+            size_type i = 0;
+            try {
+                for (; i < size_; ++i)
+                    alloc_traits::construct(alloc_, to + i, static_cast<relocation_source_t<F>>(from[i]));
+            } catch (...) {
+                while (i-- > 0) alloc_traits::destroy(alloc_, to + i);
+                throw;
+            }
+        }
+    }
+
+    // 回滚已经搬好的一列：拷贝出的副本要析构；逐字节复制的列只是旧列的字节，所有权仍在旧列，不能析构
+    template <class F>
+    void discard_relocated(F* to) noexcept {
+        if constexpr (!is_trivially_relocatable<F>::value) destroy_column(to, 0, size_);
+    }
+
+    template <class F>
+    void destroy_relocated(F* from) noexcept {
+        if constexpr (!is_trivially_relocatable<F>::value) destroy_column(from, 0, size_);
+    }
+
+    // 换到容量为 new_cap 的新块：先 extra(new_cols) 在第 size_ 行起构造 added 个新行，再把旧行搬过去
+    template <class Extra>
+    void regrow(size_type new_cap, size_type added, Extra&& extra) {
+        size_type lines = lines_for(new_cap);
+        Line* block = alloc_traits::allocate(alloc_, lines);
+        pointers cols = carve(indices{}, block, new_cap);
+        try {
+            extra(cols);
+        } catch (...) {
+            alloc_traits::deallocate(alloc_, block, lines);
+            throw;
+        }
+        try {
+            relocate_columns(indices{}, cols);
+        } catch (...) {
+            destroy_rows(indices{}, cols, size_, size_ + added);
+            alloc_traits::deallocate(alloc_, block, lines);
+            throw;
+        }
+        destroy_sources(indices{});
+        if (block_) alloc_traits::deallocate(alloc_, block_, block_lines_);
+        block_ = block;
+        block_lines_ = lines;
+        columns_ = cols;
+        capacity_ = new_cap;
+    }
+
+    // 按列依次搬；第 k 列失败时丢掉已经搬好的前 k 列，旧块仍然有效
+    template <std::size_t... I>
+    void relocate_columns(std::index_sequence<I...>, pointers& to) {
+        std::size_t done = 0;
+        try {
+            ((relocate_column(std::get<I>(columns_), std::get<I>(to)), ++done), ...);
+        } catch (...) {
+            ((I < done ? discard_relocated(std::get<I>(to)) : void()), ...);
+            throw;
+        }
+    }
+
+    template <std::size_t... I>
+    void destroy_sources(std::index_sequence<I...>) noexcept {
+        (destroy_relocated(std::get<I>(columns_)), ...);
+    }
+
+    template <class F>
+    void guarded(F&& fill) {
+        try {
+            fill();
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    void copy_from(const BasicSoASeq& other) {
+        reserve(other.size_);
+        for (size_type i = 0; i < other.size_; ++i) copy_row(indices{}, other, i);
+    }
+
+    template <std::size_t... I>
+    void copy_row(std::index_sequence<I...>, const BasicSoASeq& other, size_type row) {
+        construct_row(indices{}, columns_, size_, std::get<I>(other.columns_)[row]...);
+        ++size_;
+    }
+
+    template <std::size_t... I>
+    void move_row(std::index_sequence<I...>, BasicSoASeq& other, size_type row) {
+        construct_row(indices{}, columns_, size_, std::move(std::get<I>(other.columns_)[row])...);
+        ++size_;
+    }
+
+    void release() noexcept {
+        clear();
+        if (block_) alloc_traits::deallocate(alloc_, block_, block_lines_);
+        block_ = nullptr;
+        block_lines_ = 0;
+        columns_ = pointers{};
+        capacity_ = 0;
+    }
+
+    void steal(BasicSoASeq& other) noexcept {
+        block_ = other.block_;
+        block_lines_ = other.block_lines_;
+        columns_ = other.columns_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.block_ = nullptr;
+        other.block_lines_ = 0;
+        other.columns_ = pointers{};
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+};
+
+template <typename... Fields>
+using SoASeq = BasicSoASeq<std::allocator<char>, DoublingGrowth<>, Fields...>;
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+// 不用堆的定长池分配器：每个 (T, N, Tag) 组合有一块静态存储，放 N 个 T 大小的槽位。
+// - 存储是常量初始化的静态对象（在 .bss 里），程序启动时不做任何初始化，也不调用 malloc；
+// - allocate / deallocate 都是 O(1)：先顺序切出从未用过的槽位，之后复用空闲链表，没有循环、没有系统调用；
+// - 槽位用完时抛 std::bad_alloc，上限在编译期确定；
+// - 只分配单个对象（n == 1），适合 std::map / std::set / std::list 这类节点容器；
+//   rebind 到节点类型后得到的是节点类型自己的 N 个槽位；连续数组请用 InplaceSeq；
+// - 有的标准库（MSVC）的 std::map / std::list 还会从分配器申请一个头（哨兵）节点，
+//   libstdc++ 的头节点在容器对象里；要放 n 个元素时按 n + 1 个槽位取 N，两种实现都不会碰堆；
+// - 同一个 (T, N, Tag) 的所有实例共享存储，彼此相等；不同的池用不同的 Tag 区分。
+// 不加锁：同一个 Tag 只能在一个线程里使用。
+
+namespace pool_detail {
+
+template <class T, std::size_t N>
+class StaticSlots {
+public:
+    constexpr StaticSlots() noexcept : slots_{} {}
+
+    T* allocate() {
+        Slot* s = free_;
+        if (s) {
+            free_ = s->next;
+        } else if (carved_ < N) {
+            s = &slots_[carved_++];
+        } else {
+            throw std::bad_alloc();
+        }
+        ++in_use_;
+        return reinterpret_cast<T*>(s->bytes);
+    }
+
+    void deallocate(T* p) noexcept {
+        Slot* s = reinterpret_cast<Slot*>(p);
+        s->next = free_;
+        free_ = s;
+        --in_use_;
+    }
+
+    std::size_t in_use() const noexcept { return in_use_; }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    Slot slots_[N];
+    Slot* free_ = nullptr;
+    std::size_t carved_ = 0;
+    std::size_t in_use_ = 0;
+};
+
+} // namespace pool_detail
+
+template <typename T, std::size_t N, typename Tag = void>
+class StaticPoolAllocator {
+    static_assert(N > 0, "StaticPoolAllocator needs at least one slot");
+
+public:
+    using value_type = T;
+    using pointer = T*;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using is_always_equal = std::true_type;
+
+    template <class U> struct rebind { using other = StaticPoolAllocator<U, N, Tag>; };
+
+    constexpr StaticPoolAllocator() noexcept = default;
+    constexpr StaticPoolAllocator(const StaticPoolAllocator&) noexcept = default;
+    template <class U>
+    constexpr StaticPoolAllocator(const StaticPoolAllocator<U, N, Tag>&) noexcept {}
+
+    pointer allocate(size_type n) {
+        if (n != 1) throw std::bad_alloc();
+        return slots_.allocate();
+    }
+
+    void deallocate(pointer p, size_type) noexcept { slots_.deallocate(p); }
+
+    // 容器把它当作元素个数上限；一次只能分配一个对象由 allocate 检查
+    static constexpr size_type max_size() noexcept { return N; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    // 当前被占用的槽位数
+    static size_type in_use() noexcept { return slots_.in_use(); }
+
+    template <class U>
+    constexpr bool operator==(const StaticPoolAllocator<U, N, Tag>&) const noexcept { return true; }
+    template <class U>
+    constexpr bool operator!=(const StaticPoolAllocator<U, N, Tag>&) const noexcept { return false; }
+
+private:
+    static inline pool_detail::StaticSlots<T, N> slots_;
+};
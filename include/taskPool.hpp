@@ -0,0 +1,225 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "poolAllocator.hpp"
+#include "concurrentPoolAllocator.hpp"
+
+// 工作窃取线程池：
+// - 每个工作线程有自己的任务队列，自己从队尾取（后进先出，缓存热），空闲的线程从别人队头偷（先进先出，偷到的是大块）；
+// - 工作线程里提交的任务进自己的队列，池外线程提交的任务轮流分给各个队列；
+// - TaskGroup 统计一组任务，wait() 的线程不会干等，而是一起执行队列里的任务，所以任务里再开 TaskGroup 也不会死锁；
+//   组内第一个异常在 wait() 里重新抛出；
+// - scratch_allocator<T>() 是每个线程自己的 PoolAllocator，线程退出前一直复用，给并行算法的临时缓冲区用。
+//   PoolAllocator 不加锁，从它拿到的内存必须在同一个线程里释放。
+
+class TaskPool;
+
+namespace par_detail {
+
+using size_type = std::size_t;
+
+inline thread_local TaskPool* current_pool = nullptr;
+inline thread_local size_type current_worker = 0;
+
+} // namespace par_detail
+
+template <typename T>
+PoolAllocator<T> scratch_allocator() {
+    thread_local PoolAllocator<char> alloc;
+    return PoolAllocator<T>(alloc);
+}
+
+class TaskPool {
+public:
+    using size_type = par_detail::size_type;
+    using task_type = std::function<void()>;
+
+    // threads 为 0 时按硬件线程数减一（调用 wait() 的线程也会干活）
+    explicit TaskPool(size_type threads = 0) {
+        if (threads == 0) {
+            size_type hw = std::thread::hardware_concurrency();
+            threads = hw > 1 ? hw - 1 : 1;
+        }
+        queues_.reset(new Queue[threads]);
+        queue_count_ = threads;
+        workers_.reserve(threads);
+        try {
+            for (size_type i = 0; i < threads; ++i) workers_.emplace_back([this, i] { run_worker(i); });
+        } catch (...) {
+            shutdown();
+            throw;
+        }
+    }
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    ~TaskPool() { shutdown(); }
+
+    size_type worker_count() const noexcept { return queue_count_; }
+
+    // 进程内共享的默认池
+    static TaskPool& shared() {
+        static TaskPool pool;
+        return pool;
+    }
+
+    void submit(task_type task) {
+        size_type q;
+        if (par_detail::current_pool == this)
+            q = par_detail::current_worker;
+        else
+            q = next_queue_.fetch_add(1, std::memory_order_relaxed) % queue_count_;
+        {
+            std::lock_guard<std::mutex> lock(queues_[q].mutex);
+            queues_[q].tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            ++queued_;
+        }
+        wake_.notify_one();
+    }
+
+    // 执行一个排队的任务（先自己的队列，再从别人那里偷）；没有任务时返回 false
+    bool try_run_one() {
+        size_type home = par_detail::current_pool == this ? par_detail::current_worker : 0;
+        task_type task;
+        if (!take(home, task)) return false;
+        task();
+        return true;
+    }
+
+private:
+    struct alignas(pool_detail::cache_line_size) Queue {
+        std::mutex mutex;
+        std::deque<task_type> tasks;
+    };
+
+    std::unique_ptr<Queue[]> queues_;
+    size_type queue_count_ = 0;
+    std::vector<std::thread> workers_;
+    std::atomic<size_type> next_queue_{0};
+
+    // queued_ 是所有队列里的任务总数，只在 sleep_mutex_ 里修改，空闲线程据此睡眠
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    size_type queued_ = 0;
+    bool stop_ = false;
+
+    bool take(size_type home, task_type& out) {
+        {
+            Queue& q = queues_[home];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                out = std::move(q.tasks.back());
+                q.tasks.pop_back();
+                return taken();
+            }
+        }
+        for (size_type k = 1; k < queue_count_; ++k) {
+            Queue& q = queues_[(home + k) % queue_count_];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                out = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                return taken();
+            }
+        }
+        return false;
+    }
+
+    bool taken() {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        --queued_;
+        return true;
+    }
+
+    void run_worker(size_type index) {
+        par_detail::current_pool = this;
+        par_detail::current_worker = index;
+        for (;;) {
+            task_type task;
+            if (take(index, task)) {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+            if (stop_ && queued_ == 0) return;
+        }
+    }
+
+    void shutdown() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : workers_)
+            if (t.joinable()) t.join();
+        workers_.clear();
+    }
+};
+
+// 一组任务：run() 提交，wait() 等全部完成。组必须在 wait() 返回后才能析构。
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskPool& pool = TaskPool::shared()) noexcept : pool_(&pool) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup() {
+        while (pending_.load(std::memory_order_acquire) != 0) help();
+    }
+
+    TaskPool& pool() const noexcept { return *pool_; }
+
+    template <class F>
+    void run(F&& f) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        try {
+            pool_->submit([this, fn = std::forward<F>(f)]() mutable {
+                try {
+                    fn();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex_);
+                    if (!error_) error_ = std::current_exception();
+                }
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+            });
+        } catch (...) {
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    void wait() {
+        while (pending_.load(std::memory_order_acquire) != 0) help();
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            e = std::exchange(error_, nullptr);
+        }
+        if (e) std::rethrow_exception(e);
+    }
+
+private:
+    TaskPool* pool_;
+    std::atomic<TaskPool::size_type> pending_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+
+    void help() {
+        if (!pool_->try_run_one()) std::this_thread::yield();
+    }
+};
@@ -1,8 +1,17 @@
 #include <iostream>
 #include <map>
+#include <memory_resource>
 #include <functional>
+#include <thread>
+#include <vector>
 #include "../include/poolAllocator.hpp"
+#include "../include/concurrentPoolAllocator.hpp"
+#include "../include/arenaAllocator.hpp"
+#include "../include/poolResource.hpp"
 #include "../include/simpleSeq.hpp"
+#include "../include/flatMap.hpp"
+#include "../include/staticPoolAllocator.hpp"
+#include "../include/inplaceSeq.hpp"
 
 using namespace std;
 
@@ -26,6 +35,15 @@ int main() {
 
     for (int i = 0; i < 10; ++i) m2[i] = static_cast<int>(factorial(i));
     for (auto &p : m2) cout << p.first << " " << p.second << "\n";
+    pool10.dump_stats(cout);
+
+    cout << "\n=== FlatMap with PoolAllocator (sorted arrays, batch insert) ===\n";
+    std::vector<std::pair<int,int>> table;
+    for (int i = 9; i >= 0; --i) table.emplace_back(i, static_cast<int>(factorial(i)));
+    FlatMap<int,int, std::less<int>, PoolAllocator<PairType>> fm(std::less<int>(), pool10);
+    fm.insert(table.begin(), table.end());
+    for (auto p : fm) cout << p.first << " " << p.second << "\n";
+    cout << "fm.find(7) -> " << fm.find(7)->second << "\n";
 
     cout << "\n=== SimpleSeq<int> with default allocator ===\n";
     SimpleSeq<int> s1;
@@ -42,5 +60,83 @@ int main() {
     for (int x : s2) cout << x << " ";
     cout << "\n";
 
+    cout << "\n=== pmr::map, pmr::vector and SimpleSeq sharing one PoolResource ===\n";
+    PoolResource resource;
+    std::pmr::map<int,int> pm(&resource);
+    std::pmr::vector<int> pv(&resource);
+    SimpleSeq<int, std::pmr::polymorphic_allocator<int>> ps(0, &resource);
+    for (int i = 0; i < 10; ++i) {
+        pm[i] = static_cast<int>(factorial(i));
+        pv.push_back(i * i);
+        ps.push_back(i);
+    }
+    cout << "pm[9] = " << pm[9] << ", pv.back() = " << pv.back() << ", ps.size() = " << ps.size() << "\n";
+
+    cout << "\n=== std::map per request on an ArenaAllocator, reset() between requests ===\n";
+    using ArenaPairAlloc = ArenaAllocator<PairType>;
+    ArenaPairAlloc arena;
+    for (int request = 0; request < 3; ++request) {
+        {
+            std::map<int,int, std::less<int>, ArenaPairAlloc> m(std::less<int>(), arena);
+            for (int i = 0; i < 10; ++i) m[i] = static_cast<int>(factorial(i)) + request;
+            cout << "request " << request << ": m[9] = " << m[9] << "\n";
+        }
+        arena.reset();
+    }
+
+    cout << "\n=== std::map and InplaceSeq on static storage (no heap) ===\n";
+    // 10 个元素加上部分标准库从分配器申请的头节点
+    using StaticPairAlloc = StaticPoolAllocator<PairType, 11>;
+    std::map<int,int, std::less<int>, StaticPairAlloc> sm;
+    InplaceSeq<int, 10> squares;
+    for (int i = 0; i < 10; ++i) {
+        sm[i] = static_cast<int>(factorial(i));
+        squares.push_back(i * i);
+    }
+    cout << "sm[9] = " << sm[9] << ", squares[9] = " << squares[9]
+         << ", squares full: " << (squares.full() ? "yes" : "no") << "\n";
+
+    cout << "\n=== std::map per thread sharing one ConcurrentPoolAllocator ===\n";
+    using SharedPairAlloc = ConcurrentPoolAllocator<PairType>;
+    SharedPairAlloc shared_pool(4 * 1000);
+    const int thread_count = 4;
+    std::vector<long long> sums(thread_count);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_count; ++t) {
+        workers.emplace_back([&, t] {
+            std::map<int,int, std::less<int>, SharedPairAlloc> m(std::less<int>(), shared_pool);
+            for (int i = 0; i < 1000; ++i) m[i] = i * (t + 1);
+            long long sum = 0;
+            for (auto &p : m) sum += p.second;
+            sums[t] = sum;
+        });
+    }
+    for (auto &w : workers) w.join();
+    std::uint64_t served = 0;
+    for (auto &s : shared_pool.thread_stats()) served += s.hits + s.misses;
+    for (int t = 0; t < thread_count; ++t) cout << "thread " << t << " sum " << sums[t] << "\n";
+    cout << "node allocations served by thread caches: " << served << "\n";
+
+#if POOL_ALLOCATOR_CHECKED
+    cout << "\n=== checked mode catches a double free and a wrong n ===\n";
+    {
+        PoolCorruptionHandler previous = set_pool_corruption_handler(
+            [](const char* what, const void*) { cout << "caught: " << what << "\n"; });
+        PoolAllocator<int> checked;
+        int* one = checked.allocate(1);
+        checked.deallocate(one, 1);
+        checked.deallocate(one, 1);
+        int* many = checked.allocate(8);
+        checked.deallocate(many, 4);
+        checked.deallocate(many, 8);
+        set_pool_corruption_handler(previous);
+    }
+#endif
+
+#if POOL_ALLOCATOR_TRACE
+    AllocTraceBuffer::global().write_file("pool_trace.bin");
+    cout << "\nwrote " << AllocTraceBuffer::global().recorded() << " allocation events to pool_trace.bin\n";
+#endif
+
     return 0;
 }
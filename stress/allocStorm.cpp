@@ -0,0 +1,148 @@
+// 多线程分配风暴：每个线程维护 --size 个存活对象的窗口，每次操作随机挑一个位置，
+// 释放原来的对象、分配一个新的并写入首字节。
+// 对象大小混合 16 / 64 / 256 字节的单个对象（slab 路径）和 512 ~ 8192 字节的数组（大块路径），
+// 各线程只释放自己分配的对象。ops 是所有线程的操作总数。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "stressCommon.hpp"
+#include "../include/poolAllocator.hpp"
+#include "../include/concurrentPoolAllocator.hpp"
+#include "../include/poolResource.hpp"
+
+namespace {
+
+template <std::size_t N>
+struct Blob {
+    unsigned char bytes[N];
+};
+
+struct Live {
+    void* p = nullptr;
+    std::uint32_t kind = 0;
+    std::uint32_t n = 0;
+};
+
+constexpr std::uint32_t kinds = 4;
+
+// 同一个分配器 rebind 出的几种形状；Alloc 的 value_type 是 char
+template <class Alloc>
+class Shapes {
+    template <class U>
+    using rebound = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
+
+public:
+    explicit Shapes(const Alloc& a) : small_(a), medium_(a), big_(a), array_(a) {}
+
+    Live allocate(std::uint64_t r) {
+        Live l;
+        l.kind = static_cast<std::uint32_t>(r % kinds);
+        switch (l.kind) {
+        case 0: l.p = small_.allocate(1); break;
+        case 1: l.p = medium_.allocate(1); break;
+        case 2: l.p = big_.allocate(1); break;
+        default:
+            l.n = 512u << ((r >> 8) % 5);
+            l.p = array_.allocate(l.n);
+            break;
+        }
+        *static_cast<unsigned char*>(l.p) = static_cast<unsigned char>(r);
+        return l;
+    }
+
+    void deallocate(const Live& l) {
+        switch (l.kind) {
+        case 0: small_.deallocate(static_cast<Blob<16>*>(l.p), 1); break;
+        case 1: medium_.deallocate(static_cast<Blob<64>*>(l.p), 1); break;
+        case 2: big_.deallocate(static_cast<Blob<256>*>(l.p), 1); break;
+        default: array_.deallocate(static_cast<char*>(l.p), l.n); break;
+        }
+    }
+
+private:
+    rebound<Blob<16>> small_;
+    rebound<Blob<64>> medium_;
+    rebound<Blob<256>> big_;
+    rebound<char> array_;
+};
+
+// make(t) 在第 t 个工作线程里调用，返回该线程使用的 char 分配器
+template <class MakeAlloc>
+stress::CaseResult storm(const stress::Args& a, MakeAlloc make) {
+    std::vector<stress::LatencySampler> latency;
+    for (unsigned t = 0; t < a.threads; ++t) latency.emplace_back(a.ops);
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < a.threads; ++t) {
+        workers.emplace_back([&, t] {
+            auto alloc = make(t);
+            Shapes<decltype(alloc)> shapes(alloc);
+            std::vector<Live> window(a.size);
+            std::uint64_t rng = 0x9E3779B97F4A7C15ull + t;
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (std::uint64_t i = 0; i < a.ops; ++i) {
+                std::uint64_t r = stress::next_random(rng);
+                Live& slot = window[r % a.size];
+                latency[t].step(i, [&] {
+                    if (slot.p) shapes.deallocate(slot);
+                    slot = shapes.allocate(r >> 16);
+                });
+            }
+            for (Live& l : window)
+                if (l.p) shapes.deallocate(l);
+        });
+    }
+    while (ready.load() != a.threads) std::this_thread::yield();
+    auto start = stress::clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) w.join();
+    stress::CaseResult r;
+    r.seconds = std::chrono::duration<double>(stress::clock::now() - start).count();
+    r.ops = a.ops * a.threads;
+    for (auto& l : latency) r.latency.merge(l);
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    stress::Args args = stress::parse_args(argc, argv, 2000000, 4096);
+    const char* bench = "allocStorm";
+    stress::print_header(bench, args);
+    bool ok = true;
+
+    ok &= stress::run_case(args, bench, "std_allocator", [](const stress::Args& a) {
+        return storm(a, [](unsigned) { return std::allocator<char>(); });
+    });
+
+    // 每个线程一个独立的 PoolAllocator，没有共享也没有锁
+    ok &= stress::run_case(args, bench, "PoolAllocator_per_thread", [](const stress::Args& a) {
+        return storm(a, [](unsigned) { return PoolAllocator<char>(); });
+    });
+
+    ok &= stress::run_case(args, bench, "ConcurrentPoolAllocator_shared", [](const stress::Args& a) {
+        ConcurrentPoolAllocator<char> shared;
+        return storm(a, [&](unsigned) { return shared; });
+    });
+
+    ok &= stress::run_case(args, bench, "PoolResource_per_thread", [](const stress::Args& a) {
+        std::vector<std::unique_ptr<PoolResource>> resources;
+        for (unsigned t = 0; t < a.threads; ++t) resources.push_back(std::make_unique<PoolResource>());
+        return storm(a, [&](unsigned t) { return std::pmr::polymorphic_allocator<char>(resources[t].get()); });
+    });
+
+    ok &= stress::run_case(args, bench, "SynchronizedPoolResource_shared", [](const stress::Args& a) {
+        SynchronizedPoolResource shared;
+        return storm(a, [&](unsigned) { return std::pmr::polymorphic_allocator<char>(&shared); });
+    });
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// std::map 稳态增删：先插入 --size 个随机键，之后每次操作删掉一个已有键、插入一个新键，
+// 容器规模保持不变，节点不断释放和复用。单线程；ops 是“删一个 + 插一个”的次数。
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "stressCommon.hpp"
+#include "../include/poolAllocator.hpp"
+#include "../include/poolResource.hpp"
+
+namespace {
+
+using Key = std::uint64_t;
+using Value = std::pair<const Key, std::uint64_t>;
+
+template <class Map>
+stress::CaseResult churn(const stress::Args& a, Map& m) {
+    std::vector<Key> keys;
+    keys.reserve(a.size);
+    std::uint64_t rng = 0x2545F4914F6CDD1Dull;
+    while (keys.size() < a.size) {
+        Key k = stress::next_random(rng);
+        if (m.emplace(k, k).second) keys.push_back(k);
+    }
+
+    stress::CaseResult r;
+    r.latency = stress::LatencySampler(a.ops);
+    auto start = stress::clock::now();
+    for (std::uint64_t i = 0; i < a.ops; ++i) {
+        std::uint64_t x = stress::next_random(rng);
+        Key& slot = keys[x % a.size];
+        r.latency.step(i, [&] {
+            m.erase(slot);
+            Key k = x;
+            while (!m.emplace(k, i).second) k = stress::next_random(rng);
+            slot = k;
+        });
+    }
+    r.seconds = std::chrono::duration<double>(stress::clock::now() - start).count();
+    r.ops = a.ops;
+    stress::keep(m.size());
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    stress::Args args = stress::parse_args(argc, argv, 2000000, 100000);
+    const char* bench = "mapChurn";
+    stress::print_header(bench, args);
+    bool ok = true;
+
+    ok &= stress::run_case(args, bench, "std_allocator", [](const stress::Args& a) {
+        std::map<Key, std::uint64_t> m;
+        return churn(a, m);
+    });
+
+    ok &= stress::run_case(args, bench, "PoolAllocator", [](const stress::Args& a) {
+        std::map<Key, std::uint64_t, std::less<Key>, PoolAllocator<Value>> m;
+        return churn(a, m);
+    });
+
+    // 预留 size 个节点：稳态下节点全部来自预留块
+    ok &= stress::run_case(args, bench, "PoolAllocator_reserved", [](const stress::Args& a) {
+        PoolAllocator<Value> alloc(a.size);
+        std::map<Key, std::uint64_t, std::less<Key>, PoolAllocator<Value>> m(std::less<Key>(), alloc);
+        return churn(a, m);
+    });
+
+    ok &= stress::run_case(args, bench, "PoolResource_pmr", [](const stress::Args& a) {
+        PoolResource resource;
+        std::pmr::map<Key, std::uint64_t> m(&resource);
+        return churn(a, m);
+    });
+
+    return ok ? 0 : 1;
+}
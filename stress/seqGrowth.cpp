@@ -0,0 +1,68 @@
+// 顺序容器增长：反复从空开始 push_back 到 --size 个元素再销毁，每轮都要重新扩容。
+// 分配器在各轮之间保留，PoolAllocator 的大块缓存可以被下一轮复用。
+// ops 是 push_back 总次数（约 --ops，按整轮取整）；抽样延迟里偶尔的扩容决定 p99。
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "stressCommon.hpp"
+#include "../include/poolAllocator.hpp"
+#include "../include/simpleSeq.hpp"
+
+namespace {
+
+template <class Seq, class Alloc>
+stress::CaseResult grow(const stress::Args& a, const Alloc& alloc) {
+    std::uint64_t rounds = std::max<std::uint64_t>(1, a.ops / a.size);
+    stress::CaseResult r;
+    r.latency = stress::LatencySampler(rounds * a.size);
+    std::uint64_t i = 0;
+    auto start = stress::clock::now();
+    for (std::uint64_t round = 0; round < rounds; ++round) {
+        Seq seq(alloc);
+        for (std::size_t k = 0; k < a.size; ++k, ++i)
+            r.latency.step(i, [&] { seq.push_back(static_cast<std::uint32_t>(k)); });
+        stress::keep(seq.data()[a.size / 2]);
+    }
+    r.seconds = std::chrono::duration<double>(stress::clock::now() - start).count();
+    r.ops = i;
+    return r;
+}
+
+// SimpleSeq 的分配器参数跟在预留容量后面
+template <class Growth, class Alloc>
+struct SimpleSeqOf : SimpleSeq<std::uint32_t, Alloc, Growth> {
+    explicit SimpleSeqOf(const Alloc& alloc) : SimpleSeq<std::uint32_t, Alloc, Growth>(0, alloc) {}
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    stress::Args args = stress::parse_args(argc, argv, 20000000, 1000000);
+    const char* bench = "seqGrowth";
+    stress::print_header(bench, args);
+    bool ok = true;
+
+    ok &= stress::run_case(args, bench, "std_vector", [](const stress::Args& a) {
+        return grow<std::vector<std::uint32_t>>(a, std::allocator<std::uint32_t>());
+    });
+
+    ok &= stress::run_case(args, bench, "SimpleSeq_std_allocator", [](const stress::Args& a) {
+        using A = std::allocator<std::uint32_t>;
+        return grow<SimpleSeqOf<DoublingGrowth<>, A>>(a, A());
+    });
+
+    ok &= stress::run_case(args, bench, "SimpleSeq_PoolAllocator", [](const stress::Args& a) {
+        using A = PoolAllocator<std::uint32_t>;
+        return grow<SimpleSeqOf<DoublingGrowth<>, A>>(a, A());
+    });
+
+    // 容量取整到大块级别，级别内的余量靠 try_expand 原地扩容
+    ok &= stress::run_case(args, bench, "SimpleSeq_PoolAllocator_size_class", [](const stress::Args& a) {
+        using A = PoolAllocator<std::uint32_t>;
+        return grow<SimpleSeqOf<PoolSizeClassGrowth<>, A>>(a, A());
+    });
+
+    return ok ? 0 : 1;
+}
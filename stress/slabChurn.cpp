@@ -0,0 +1,70 @@
+// slab 随机增删：先分配 --size 个 32 字节对象，之后每次操作随机释放一个、再分配一个。
+// 随机释放让空位散落在所有块里，衡量“当前块满了，换哪个块”这一步在块数很多时的开销；
+// fixed:64 的块最多，geometric 是默认配置。单线程；ops 是“释放一个 + 分配一个”的次数。
+// 换不同的 --size（例如 20000 / 200000 / 800000）运行，看每次操作的耗时是否随块数增长。
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "stressCommon.hpp"
+#include "../include/poolAllocator.hpp"
+
+namespace {
+
+struct Node {
+    unsigned char bytes[32];
+};
+
+template <class Alloc>
+stress::CaseResult churn(const stress::Args& a, Alloc alloc) {
+    std::vector<Node*> live(a.size);
+    for (Node*& p : live) p = alloc.allocate(1);
+
+    std::uint64_t rng = 0x94D049BB133111EBull;
+    stress::CaseResult r;
+    r.latency = stress::LatencySampler(a.ops);
+    auto start = stress::clock::now();
+    for (std::uint64_t i = 0; i < a.ops; ++i) {
+        Node*& slot = live[stress::next_random(rng) % a.size];
+        r.latency.step(i, [&] {
+            alloc.deallocate(slot, 1);
+            slot = alloc.allocate(1);
+            slot->bytes[0] = static_cast<unsigned char>(i);
+        });
+    }
+    r.seconds = std::chrono::duration<double>(stress::clock::now() - start).count();
+    r.ops = a.ops;
+    for (Node* p : live) alloc.deallocate(p, 1);
+    return r;
+}
+
+PoolOptions fixed_blocks(std::size_t slots) {
+    PoolOptions o;
+    o.growth = BlockGrowth::fixed;
+    o.initial_block_slots = slots;
+    return o;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    stress::Args args = stress::parse_args(argc, argv, 4000000, 200000);
+    const char* bench = "slabChurn";
+    stress::print_header(bench, args);
+    bool ok = true;
+
+    ok &= stress::run_case(args, bench, "std_allocator", [](const stress::Args& a) {
+        return churn(a, std::allocator<Node>());
+    });
+
+    ok &= stress::run_case(args, bench, "PoolAllocator_geometric", [](const stress::Args& a) {
+        return churn(a, PoolAllocator<Node>());
+    });
+
+    ok &= stress::run_case(args, bench, "PoolAllocator_fixed64", [](const stress::Args& a) {
+        return churn(a, PoolAllocator<Node>(0, fixed_blocks(64)));
+    });
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// 压力测试共用的部分：参数、延迟采样、每个用例一个子进程，以及结果输出。
+// 每个用例输出总操作数、每秒操作数、抽样延迟的 p50 / p99（纳秒）和峰值 RSS（相对用例开始时）。
+// 用例在单独 fork 出来的子进程里跑，峰值 RSS 互不影响；--csv 把结果追加到文件，便于跨版本对比。
+// 通用参数：--ops N（每个线程的操作数）、--size N（存活对象数 / 容器规模）、--threads N、--csv FILE；
+// 其余参数当作用例名，只跑列出的用例。
+
+namespace stress {
+
+using clock = std::chrono::steady_clock;
+
+struct Args {
+    std::uint64_t ops;
+    std::size_t size;
+    unsigned threads;
+    std::string csv;
+    std::vector<std::string> only;
+};
+
+inline Args parse_args(int argc, char** argv, std::uint64_t default_ops, std::size_t default_size) {
+    Args a{default_ops, default_size, std::max(2u, static_cast<unsigned>(::sysconf(_SC_NPROCESSORS_ONLN))), {}, {}};
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--ops" && has_value)
+            a.ops = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--size" && has_value)
+            a.size = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--threads" && has_value)
+            a.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--csv" && has_value)
+            a.csv = argv[++i];
+        else if (arg.compare(0, 2, "--") == 0) {
+            std::fprintf(stderr, "usage: %s [--ops N] [--size N] [--threads N] [--csv FILE] [case...]\n", argv[0]);
+            std::exit(2);
+        } else
+            a.only.push_back(arg);
+    }
+    if (a.ops == 0 || a.size == 0 || a.threads == 0) {
+        std::fprintf(stderr, "%s: --ops, --size and --threads must be positive\n", argv[0]);
+        std::exit(2);
+    }
+    return a;
+}
+
+// 不让编译器把只写不读的结果优化掉
+template <class T>
+inline void keep(const T& v) noexcept {
+    asm volatile("" : : "r"(&v) : "memory");
+}
+
+// 每 every 次操作计时一次；样本空间预先分配，计时循环里不分配内存
+class LatencySampler {
+public:
+    static constexpr std::uint64_t every = 64;
+
+    explicit LatencySampler(std::uint64_t expected_ops = 0) { samples_.reserve(expected_ops / every + 1); }
+
+    template <class F>
+    void step(std::uint64_t i, F&& op) {
+        if (i % every != 0) {
+            op();
+            return;
+        }
+        auto start = clock::now();
+        op();
+        samples_.push_back(static_cast<std::uint32_t>(
+            std::min<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count(),
+                                   UINT32_MAX)));
+    }
+
+    void merge(const LatencySampler& other) {
+        samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+    }
+
+    // q 取 0 ~ 1
+    double percentile(double q) {
+        if (samples_.empty()) return 0;
+        std::size_t k = std::min(samples_.size() - 1, static_cast<std::size_t>(q * samples_.size()));
+        std::nth_element(samples_.begin(), samples_.begin() + k, samples_.end());
+        return samples_[k];
+    }
+
+private:
+    std::vector<std::uint32_t> samples_;
+};
+
+struct CaseResult {
+    std::uint64_t ops = 0;
+    double seconds = 0;
+    LatencySampler latency;
+};
+
+inline long current_rss_kb() {
+    long pages = 0, resident = 0;
+    if (FILE* f = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+        std::fclose(f);
+    }
+    return resident * (::sysconf(_SC_PAGESIZE) / 1024);
+}
+
+inline void print_header(const char* bench, const Args& a) {
+    std::printf("%s: ops=%llu size=%zu threads=%u\n", bench, static_cast<unsigned long long>(a.ops), a.size,
+                a.threads);
+    std::printf("%-36s %12s %14s %10s %10s %12s\n", "case", "ops", "ops_per_sec", "p50_ns", "p99_ns", "peak_rss_kb");
+    std::fflush(stdout);
+}
+
+inline void write_row(const Args& a, const char* bench, const char* name, CaseResult& r, long rss_kb) {
+    double rate = r.seconds > 0 ? r.ops / r.seconds : 0;
+    double p50 = r.latency.percentile(0.50);
+    double p99 = r.latency.percentile(0.99);
+    std::printf("%-36s %12llu %14.0f %10.0f %10.0f %12ld\n", name, static_cast<unsigned long long>(r.ops), rate, p50,
+                p99, rss_kb);
+    std::fflush(stdout);
+    if (a.csv.empty()) return;
+    FILE* f = std::fopen(a.csv.c_str(), "a");
+    if (!f) {
+        std::perror(a.csv.c_str());
+        return;
+    }
+    if (std::ftell(f) == 0) std::fprintf(f, "benchmark,case,ops,ops_per_sec,p50_ns,p99_ns,peak_rss_kb\n");
+    std::fprintf(f, "%s,%s,%llu,%.0f,%.0f,%.0f,%ld\n", bench, name, static_cast<unsigned long long>(r.ops), rate, p50,
+                 p99, rss_kb);
+    std::fclose(f);
+}
+
+// 在子进程里跑 body(args)，返回 body 的 CaseResult；返回值表示用例是否成功（被过滤掉也算成功）
+template <class F>
+bool run_case(const Args& a, const char* bench, const char* name, F&& body) {
+    if (!a.only.empty() && std::find(a.only.begin(), a.only.end(), name) == a.only.end()) return true;
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        std::perror("fork");
+        return false;
+    }
+    if (pid == 0) {
+        try {
+            long base = current_rss_kb();
+            CaseResult r = body(a);
+            struct rusage ru;
+            ::getrusage(RUSAGE_SELF, &ru);
+            write_row(a, bench, name, r, std::max(0L, ru.ru_maxrss - base));
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "%s: %s\n", name, e.what());
+            std::_Exit(1);
+        }
+        std::_Exit(0);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// xorshift64；各用例用同样的种子，得到同样的操作序列，对比才公平
+inline std::uint64_t next_random(std::uint64_t& state) noexcept {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+} // namespace stress
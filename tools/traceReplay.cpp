@@ -0,0 +1,293 @@
+// 用不同的池配置重放 POOL_ALLOCATOR_TRACE 记下的分配轨迹，比较耗时、峰值 RSS 和 malloc 次数。
+// 用法：poolTraceReplay <trace.bin> [config...]
+// config 的写法：
+//   malloc                 直接用 ::operator new / delete，作为基线
+//   fixed:N                BlockGrowth::fixed，每块 N 个槽位
+//   geometric:N            BlockGrowth::geometric，首块 N 个槽位（默认配置是 geometric:16）
+//   capped:N:M             BlockGrowth::capped，首块 N 个，最多 M 个
+// 任一池配置后面加 +huge 打开 huge_pages，加 +numa 打开 numa_local。
+// 不给 config 时跑一组常用配置。每个配置在单独 fork 出来的子进程里重放，峰值 RSS 互不影响。
+// 多个线程的事件按记录顺序在一个线程里重放；记录里的时间戳只用于排序，不按原来的间隔等待。
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../include/allocTrace.hpp"
+#include "../include/poolAllocator.hpp"
+
+namespace {
+
+// 只统计重放中分配器发出的 operator new，重放器自己的簿记不算
+bool counting = false;
+std::uint64_t new_calls = 0;
+
+void* counted_new(std::size_t n, std::size_t align) {
+    if (counting) ++new_calls;
+    void* p = align > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? std::aligned_alloc(align, (n + align - 1) / align * align)
+                                                       : std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+} // namespace
+
+void* operator new(std::size_t n) { return counted_new(n, 0); }
+void* operator new[](std::size_t n) { return counted_new(n, 0); }
+void* operator new(std::size_t n, std::align_val_t a) { return counted_new(n, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t n, std::align_val_t a) { return counted_new(n, static_cast<std::size_t>(a)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Config {
+    std::string name;
+    bool use_malloc = false;
+    PoolOptions options;
+};
+
+Config parse_config(const std::string& text) {
+    Config c;
+    c.name = text;
+    if (text == "malloc") {
+        c.use_malloc = true;
+        return c;
+    }
+    std::string body = text;
+    for (;;) {
+        std::size_t plus = body.rfind('+');
+        if (plus == std::string::npos) break;
+        std::string flag = body.substr(plus + 1);
+        if (flag == "huge")
+            c.options.huge_pages = true;
+        else if (flag == "numa")
+            c.options.numa_local = true;
+        else
+            throw std::invalid_argument("unknown flag +" + flag);
+        body.resize(plus);
+    }
+    std::vector<std::string> parts;
+    for (std::size_t start = 0;;) {
+        std::size_t colon = body.find(':', start);
+        parts.push_back(body.substr(start, colon - start));
+        if (colon == std::string::npos) break;
+        start = colon + 1;
+    }
+    if (parts[0] == "fixed" && parts.size() == 2) {
+        c.options.growth = BlockGrowth::fixed;
+    } else if (parts[0] == "geometric" && parts.size() == 2) {
+        c.options.growth = BlockGrowth::geometric;
+    } else if (parts[0] == "capped" && parts.size() == 3) {
+        c.options.growth = BlockGrowth::capped;
+        c.options.max_block_slots = std::stoul(parts[2]);
+    } else {
+        throw std::invalid_argument("cannot parse config '" + text + "'");
+    }
+    c.options.initial_block_slots = std::stoul(parts[1]);
+    return c;
+}
+
+// 按 PoolAllocator 的规则分配：单个对象走 (stride, align) 对应的 slab，多个元素走 LargeBins
+class Backend {
+public:
+    explicit Backend(const Config& c) : use_malloc_(c.use_malloc), state_(c.options) {}
+
+    void* allocate(std::uint64_t count, std::size_t elem, std::size_t align) {
+        std::size_t bytes = static_cast<std::size_t>(count * elem);
+        if (use_malloc_) return ::operator new(bytes, std::align_val_t(align));
+        if (count == 1) return slab(elem, align)->allocate();
+        return state_.allocate_large(bytes, align);
+    }
+
+    void deallocate(void* p, std::uint64_t count, std::size_t elem, std::size_t align) noexcept {
+        if (use_malloc_) {
+            ::operator delete(p, std::align_val_t(align));
+        } else if (count == 1) {
+            slab(elem, align)->deallocate(p);
+        } else {
+            state_.deallocate_large(p, static_cast<std::size_t>(count * elem));
+        }
+    }
+
+    bool expand(void* p, std::uint64_t new_count, std::size_t elem) noexcept {
+        if (use_malloc_) return false;
+        return state_.try_expand_large(p, static_cast<std::size_t>(new_count * elem));
+    }
+
+private:
+    bool use_malloc_;
+    pool_detail::PoolState state_;
+    std::map<std::pair<std::size_t, std::size_t>, pool_detail::SlabPool*> slabs_;
+
+    pool_detail::SlabPool* slab(std::size_t elem, std::size_t align) {
+        auto key = std::make_pair(elem, align);
+        auto it = slabs_.find(key);
+        if (it != slabs_.end()) return it->second;
+        pool_detail::SlabPool* s =
+            state_.pool_for(pool_detail::slot_stride(elem, align), pool_detail::slot_align(align));
+        slabs_.emplace(key, s);
+        return s;
+    }
+};
+
+// 每页写一个字节，让 RSS 反映真实使用时会被碰到的内存
+void touch(void* p, std::size_t bytes) noexcept {
+    volatile char* c = static_cast<char*>(p);
+    for (std::size_t off = 0; off < bytes; off += 4096) c[off] = 1;
+    if (bytes) c[bytes - 1] = 1;
+}
+
+long current_rss_kb() {
+    long pages = 0, resident = 0;
+    if (FILE* f = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+        std::fclose(f);
+    }
+    return resident * (::sysconf(_SC_PAGESIZE) / 1024);
+}
+
+struct Live {
+    void* p;
+    std::uint64_t count;
+    std::uint32_t elem;
+    std::size_t align;
+};
+
+void replay(const Config& config, const std::vector<AllocTraceEvent>& events) {
+    std::unordered_map<std::uint64_t, Live> live;
+    live.reserve(events.size());
+    long base_rss = current_rss_kb();
+    std::uint64_t unmatched = 0;
+
+    Backend backend(config);
+    auto start = std::chrono::steady_clock::now();
+    for (const AllocTraceEvent& e : events) {
+        std::size_t align = std::size_t(1) << e.align_log2;
+        switch (e.kind) {
+        case AllocTraceKind::allocate: {
+            counting = true;
+            void* p = backend.allocate(e.count, e.elem_size, align);
+            counting = false;
+            touch(p, static_cast<std::size_t>(e.count * e.elem_size));
+            live[e.address] = Live{p, e.count, e.elem_size, align};
+            break;
+        }
+        case AllocTraceKind::deallocate: {
+            auto it = live.find(e.address);
+            if (it == live.end()) {
+                ++unmatched;
+                break;
+            }
+            backend.deallocate(it->second.p, it->second.count, it->second.elem, it->second.align);
+            live.erase(it);
+            break;
+        }
+        case AllocTraceKind::expand: {
+            auto it = live.find(e.address);
+            if (it == live.end()) {
+                ++unmatched;
+                break;
+            }
+            Live& l = it->second;
+            counting = true;
+            // 这个配置下原地扩不了，就像 SimpleSeq 那样换一块新的
+            if (!backend.expand(l.p, e.count, l.elem)) {
+                void* fresh = backend.allocate(e.count, l.elem, l.align);
+                backend.deallocate(l.p, l.count, l.elem, l.align);
+                l.p = fresh;
+            }
+            counting = false;
+            l.count = e.count;
+            touch(l.p, static_cast<std::size_t>(e.count * l.elem));
+            break;
+        }
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    struct rusage ru;
+    ::getrusage(RUSAGE_SELF, &ru);
+    double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    std::printf("%-24s %10.2f %14ld %14llu %10zu %10llu\n", config.name.c_str(), ms,
+                std::max(0L, ru.ru_maxrss - base_rss), static_cast<unsigned long long>(new_calls), live.size(),
+                static_cast<unsigned long long>(unmatched));
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <trace.bin> [config...]\n"
+                  << "  config: malloc | fixed:N | geometric:N | capped:N:M, optionally +huge / +numa\n";
+        return 2;
+    }
+    std::vector<Config> configs;
+    try {
+        for (int i = 2; i < argc; ++i) configs.push_back(parse_config(argv[i]));
+        if (configs.empty())
+            for (const char* c : {"malloc", "geometric:16", "geometric:256", "fixed:64", "capped:16:1024"})
+                configs.push_back(parse_config(c));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    AllocTraceHeader header;
+    std::vector<AllocTraceEvent> events;
+    try {
+        events = read_alloc_trace(argv[1], &header);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    std::printf("%llu events (%llu dropped by the ring buffer)\n", static_cast<unsigned long long>(header.event_count),
+                static_cast<unsigned long long>(header.dropped));
+    std::printf("%-24s %10s %14s %14s %10s %10s\n", "config", "time_ms", "peak_rss_kb", "malloc_calls", "live_end",
+                "unmatched");
+    std::fflush(stdout);
+
+    int status = 0;
+    for (const Config& c : configs) {
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            std::perror("fork");
+            return 1;
+        }
+        if (pid == 0) {
+            try {
+                replay(c, events);
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "%s: %s\n", c.name.c_str(), e.what());
+                std::_Exit(1);
+            }
+            std::_Exit(0);
+        }
+        int child = 0;
+        ::waitpid(pid, &child, 0);
+        if (!WIFEXITED(child) || WEXITSTATUS(child) != 0) status = 1;
+    }
+    return status;
+}